@@ -0,0 +1,493 @@
+#include "sanisizer/sanisizer.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <functional>
+
+/*
+ * Self-contained timing loops for each sanisizer function.
+ * Each benchmark is run with the checked function and its unchecked equivalent (usually a static_cast or raw arithmetic),
+ * and we report the time per operation for both, along with the ratio of the checked to unchecked times.
+ *
+ * The optional first argument specifies the number of passes over the inputs for each benchmark.
+ *
+ * This file is also compiled with SANISIZER_ARITHMETIC_FORCE_MANUAL into a separate executable,
+ * so that the compiler intrinsics can be compared to the portable overflow checks.
+ */
+
+namespace {
+
+int num_passes = 200;
+
+constexpr std::size_t num_inputs = 1 << 14;
+
+template<typename Value_>
+inline void do_not_optimize(const Value_& x) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(x));
+#else
+    volatile Value_ copy = x;
+    (void)copy;
+#endif
+}
+
+template<typename Input_, class Function_>
+double time_per_op(const std::vector<Input_>& inputs, Function_ fun) {
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < num_passes; ++p) {
+        for (const auto& in : inputs) {
+            do_not_optimize(fun(in));
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(num_passes) * inputs.size());
+}
+
+void report(const std::string& name, double checked, double unchecked) {
+    std::printf("%-60s %10.3f %10.3f %8.2f\n", name.c_str(), checked, unchecked, checked / unchecked);
+}
+
+template<typename Input_, class Checked_, class Unchecked_>
+void compare(const std::string& name, const std::vector<Input_>& inputs, Checked_ checked, Unchecked_ unchecked) {
+    // Running the unchecked version first to warm up the cache.
+    const double unchecked_time = time_per_op(inputs, unchecked);
+    const double checked_time = time_per_op(inputs, checked);
+    report(name, checked_time, unchecked_time);
+}
+
+std::mt19937_64 rng(42);
+
+template<typename Integer_>
+std::vector<Integer_> create_integers(long long upper) {
+    std::uniform_int_distribution<long long> dist(0, upper);
+    std::vector<Integer_> output(num_inputs);
+    for (auto& o : output) {
+        o = dist(rng);
+    }
+    return output;
+}
+
+template<typename Integer_>
+std::vector<std::pair<Integer_, Integer_> > create_integer_pairs(long long upper) {
+    std::uniform_int_distribution<long long> dist(0, upper);
+    std::vector<std::pair<Integer_, Integer_> > output(num_inputs);
+    for (auto& o : output) {
+        o.first = dist(rng);
+        o.second = dist(rng);
+    }
+    return output;
+}
+
+template<typename Integer_>
+std::string type_name() {
+    std::string prefix = (std::is_signed<Integer_>::value ? "int" : "uint");
+    return prefix + std::to_string(sizeof(Integer_) * 8);
+}
+
+template<typename ... Types_>
+struct TypeList {};
+
+typedef TypeList<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, std::uint64_t> AllIntegers;
+
+/*** Casting ***/
+
+template<typename Dest_, typename Value_>
+void benchmark_cast() {
+    auto inputs = create_integers<Value_>(100);
+    compare(
+        "cast<" + type_name<Dest_>() + ">(" + type_name<Value_>() + ")",
+        inputs,
+        [](Value_ x) -> Dest_ { return sanisizer::cast<Dest_>(x); },
+        [](Value_ x) -> Dest_ { return static_cast<Dest_>(x); }
+    );
+}
+
+template<typename Dest_, typename ... Values_>
+void benchmark_cast_row(TypeList<Values_...>) {
+    (benchmark_cast<Dest_, Values_>(), ...);
+}
+
+template<typename ... Dests_>
+void benchmark_cast_all(TypeList<Dests_...>) {
+    (benchmark_cast_row<Dests_>(AllIntegers()), ...);
+}
+
+void benchmark_cast_attested() {
+    typedef sanisizer::Attestation<std::int64_t, 1000> Attested;
+    auto raw = create_integers<std::int64_t>(1000);
+    std::vector<Attested> inputs(raw.begin(), raw.end());
+    compare(
+        "cast<int16>(Attestation<int64, 1000>)",
+        inputs,
+        [](Attested x) -> std::int16_t { return sanisizer::cast<std::int16_t>(x); },
+        [](Attested x) -> std::int16_t { return static_cast<std::int16_t>(x.value); }
+    );
+}
+
+std::size_t takes_size(std::size_t x) {
+    return x;
+}
+
+void benchmark_cast_class() {
+    auto inputs = create_integers<int>(1000);
+    compare(
+        "Cast(int) -> size_t",
+        inputs,
+        [](int x) -> std::size_t { return takes_size(sanisizer::Cast(x)); },
+        [](int x) -> std::size_t { return takes_size(static_cast<std::size_t>(x)); }
+    );
+}
+
+/*** Arithmetic ***/
+
+template<typename Dest_, typename Value_>
+void benchmark_sum() {
+    auto inputs = create_integer_pairs<Value_>(60);
+    compare(
+        "sum<" + type_name<Dest_>() + ">(" + type_name<Value_>() + ", " + type_name<Value_>() + ")",
+        inputs,
+        [](const std::pair<Value_, Value_>& x) -> Dest_ { return sanisizer::sum<Dest_>(x.first, x.second); },
+        [](const std::pair<Value_, Value_>& x) -> Dest_ { return static_cast<Dest_>(x.first) + static_cast<Dest_>(x.second); }
+    );
+}
+
+template<typename Dest_, typename Value_>
+void benchmark_product() {
+    auto inputs = create_integer_pairs<Value_>(10);
+    compare(
+        "product<" + type_name<Dest_>() + ">(" + type_name<Value_>() + ", " + type_name<Value_>() + ")",
+        inputs,
+        [](const std::pair<Value_, Value_>& x) -> Dest_ { return sanisizer::product<Dest_>(x.first, x.second); },
+        [](const std::pair<Value_, Value_>& x) -> Dest_ { return static_cast<Dest_>(x.first) * static_cast<Dest_>(x.second); }
+    );
+}
+
+template<typename Dest_, typename ... Values_>
+void benchmark_arithmetic_row(TypeList<Values_...>) {
+    (benchmark_sum<Dest_, Values_>(), ...);
+    (benchmark_product<Dest_, Values_>(), ...);
+}
+
+template<typename ... Dests_>
+void benchmark_arithmetic_all(TypeList<Dests_...>) {
+    (benchmark_arithmetic_row<Dests_>(AllIntegers()), ...);
+}
+
+void benchmark_arithmetic_attested() {
+    typedef sanisizer::Attestation<std::uint64_t, 1000> Attested;
+    auto raw = create_integer_pairs<std::uint64_t>(1000);
+    std::vector<std::pair<Attested, Attested> > inputs;
+    inputs.reserve(raw.size());
+    for (const auto& r : raw) {
+        inputs.emplace_back(r.first, r.second);
+    }
+
+    compare(
+        "sum<uint16>(Attestation<uint64, 1000>, Attestation<uint64, 1000>)",
+        inputs,
+        [](const std::pair<Attested, Attested>& x) -> std::uint16_t { return sanisizer::sum<std::uint16_t>(x.first, x.second); },
+        [](const std::pair<Attested, Attested>& x) -> std::uint16_t { return static_cast<std::uint16_t>(x.first.value) + static_cast<std::uint16_t>(x.second.value); }
+    );
+
+    compare(
+        "product<uint32>(Attestation<uint64, 1000>, Attestation<uint64, 1000>)",
+        inputs,
+        [](const std::pair<Attested, Attested>& x) -> std::uint32_t { return sanisizer::product<std::uint32_t>(x.first, x.second); },
+        [](const std::pair<Attested, Attested>& x) -> std::uint32_t { return static_cast<std::uint32_t>(x.first.value) * static_cast<std::uint32_t>(x.second.value); }
+    );
+}
+
+void benchmark_arithmetic_large() {
+    // Values that are large enough to require a run-time check, without actually overflowing.
+    auto inputs = create_integer_pairs<std::uint64_t>(4000000000ll);
+    compare(
+        "product<uint64>(uint64, uint64) [large]",
+        inputs,
+        [](const std::pair<std::uint64_t, std::uint64_t>& x) -> std::uint64_t { return sanisizer::product<std::uint64_t>(x.first, x.second); },
+        [](const std::pair<std::uint64_t, std::uint64_t>& x) -> std::uint64_t { return x.first * x.second; }
+    );
+}
+
+template<typename Value_>
+void benchmark_ranges() {
+    // Each input is a whole vector, so the time is reported per element by dividing by the vector length.
+    std::vector<std::vector<Value_> > inputs(64);
+    for (auto& in : inputs) {
+        in = create_integers<Value_>(100);
+    }
+
+    const double divisor = num_inputs;
+    auto sum_checked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t { return sanisizer::sum_range<std::uint64_t>(x.begin(), x.end()); });
+    auto sum_unchecked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t { return std::accumulate(x.begin(), x.end(), static_cast<std::uint64_t>(0)); });
+    report("sum_range<uint64>(" + type_name<Value_>() + "...) [per element]", sum_checked / divisor, sum_unchecked / divisor);
+
+    auto prod_checked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t { return sanisizer::product_range<std::uint64_t>(x.begin(), x.begin() + 8); });
+    auto prod_unchecked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t { return std::accumulate(x.begin(), x.begin() + 8, static_cast<std::uint64_t>(1), std::multiplies<std::uint64_t>()); });
+    report("product_range<uint64>(" + type_name<Value_>() + " x 8)", prod_checked, prod_unchecked);
+}
+
+template<typename Value_>
+void benchmark_accumulator() {
+    std::vector<std::vector<Value_> > inputs(64);
+    for (auto& in : inputs) {
+        in = create_integers<Value_>(100);
+    }
+
+    const double divisor = num_inputs;
+    auto checked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t {
+        sanisizer::Accumulator<std::uint64_t> acc;
+        for (auto y : x) {
+            acc.add(y);
+        }
+        return acc.value();
+    });
+    auto unchecked = time_per_op(inputs, [](const std::vector<Value_>& x) -> std::uint64_t { return std::accumulate(x.begin(), x.end(), static_cast<std::uint64_t>(0)); });
+    report("Accumulator<uint64>::add(" + type_name<Value_>() + ") [per element]", checked / divisor, unchecked / divisor);
+}
+
+/*** Creation ***/
+
+void benchmark_create_for_overwrite() {
+    // Each input is the length of a scratch buffer, so the time is reported per element.
+    // This compares the default-initialized buffer to the usual zero-filled one, where each buffer is only touched once.
+    const std::vector<std::size_t> inputs(16, 1 << 20);
+    const double divisor = inputs.front();
+    auto overwrite = time_per_op(inputs, [](std::size_t n) -> double {
+        auto buffer = sanisizer::create_vector_for_overwrite<double>(n);
+        buffer[n / 2] = 1;
+        return buffer[n / 2];
+    });
+    auto zeroed = time_per_op(inputs, [](std::size_t n) -> double {
+        auto buffer = sanisizer::create<std::vector<double> >(n);
+        buffer[n / 2] = 1;
+        return buffer[n / 2];
+    });
+    report("create_vector_for_overwrite<double>() [per element]", overwrite / divisor, zeroed / divisor);
+}
+
+void benchmark_arena() {
+    // Each input is the length of a small vector that is created and discarded.
+    const auto inputs = create_integers<std::size_t>(32);
+    sanisizer::Arena arena(1 << 20);
+    typedef std::vector<int, sanisizer::ArenaAllocator<int> > ArenaVector;
+
+    auto bumped = time_per_op(inputs, [&](std::size_t n) -> std::size_t {
+        if (arena.available() < 1024) {
+            arena.release();
+        }
+        auto vec = sanisizer::create<ArenaVector>(n, sanisizer::ArenaAllocator<int>(arena));
+        return vec.size();
+    });
+    auto heap = time_per_op(inputs, [](std::size_t n) -> std::size_t {
+        auto vec = sanisizer::create<std::vector<int> >(n);
+        return vec.size();
+    });
+    report("create<std::vector<int, ArenaAllocator<int> > >(<= 32)", bumped, heap);
+}
+
+/*** N-dimensional offsets ***/
+
+template<typename Size_>
+void benchmark_nd_offset() {
+    std::vector<std::pair<int, int> > inputs = create_integer_pairs<int>(100);
+    compare(
+        "nd_offset<" + type_name<Size_>() + ">(int, 100, int, 100, int)",
+        inputs,
+        [](const std::pair<int, int>& x) -> Size_ { return sanisizer::nd_offset<Size_>(x.first, 100, x.second, 100, x.first); },
+        [](const std::pair<int, int>& x) -> Size_ { return x.first + 100 * (x.second + 100 * x.first); }
+    );
+}
+
+template<typename Size_>
+void benchmark_nd_offsets_bulk() {
+    struct Batch {
+        std::vector<int> x, y, z;
+        mutable std::vector<Size_> output;
+    };
+    std::vector<Batch> inputs(16);
+    for (auto& in : inputs) {
+        in.x = create_integers<int>(99);
+        in.y = create_integers<int>(99);
+        in.z = create_integers<int>(99);
+        in.output.resize(num_inputs);
+    }
+
+    const double divisor = num_inputs;
+    const sanisizer::Shape<Size_, 3> shape(100, 100, 100);
+    auto validated = time_per_op(inputs, [&](const Batch& b) -> std::size_t {
+        return shape.offsets_validated(num_inputs, std::array<const int*, 3>{ b.x.data(), b.y.data(), b.z.data() }, b.output.data());
+    });
+    auto looped = time_per_op(inputs, [](const Batch& b) -> Size_ {
+        for (std::size_t i = 0; i < num_inputs; ++i) {
+            b.output[i] = sanisizer::nd_offset<Size_>(b.x[i], 100, b.y[i], 100, b.z[i]);
+        }
+        return b.output.back();
+    });
+    report("Shape<" + type_name<Size_>() + ", 3>::offsets_validated(int...) [per element]", validated / divisor, looped / divisor);
+
+    auto bulk = time_per_op(inputs, [&](const Batch& b) -> Size_ {
+        shape.offsets(num_inputs, std::array<const int*, 3>{ b.x.data(), b.y.data(), b.z.data() }, b.output.data());
+        return b.output.back();
+    });
+    report("Shape<" + type_name<Size_>() + ", 3>::offsets(int...) [per element]", bulk / divisor, looped / divisor);
+}
+
+template<typename Size_>
+void benchmark_odometer() {
+    // Each input is a walk over a 32 x 32 x 16 region of a 64 x 64 x 64 array, so the time is reported per element.
+    // The region is derived from the input to avoid giving the nested loops an unrealistic advantage from constant trip counts.
+    const std::vector<int> inputs(16, 64);
+    const double divisor = 32 * 32 * 16;
+    std::vector<double> buffer(64 * 64 * 64);
+
+    auto nested = time_per_op(inputs, [&](int extent) -> double {
+        const std::array<int, 3> start{ extent / 8, extent / 4, extent / 2 }, count{ extent / 2, extent / 2, extent / 4 };
+        for (int k = start[2], kend = start[2] + count[2]; k < kend; ++k) {
+            for (int j = start[1], jend = start[1] + count[1]; j < jend; ++j) {
+                for (int i = start[0], iend = start[0] + count[0]; i < iend; ++i) {
+                    buffer[sanisizer::nd_offset<Size_>(i, extent, j, extent, k)] += 1;
+                }
+            }
+        }
+        return buffer[0];
+    });
+
+    auto stepped = time_per_op(inputs, [&](int extent) -> double {
+        const std::array<int, 3> start{ extent / 8, extent / 4, extent / 2 }, count{ extent / 2, extent / 2, extent / 4 };
+        for (sanisizer::Odometer<Size_, 3> odo(std::array<int, 3>{ extent, extent, extent }, start, count); odo.valid(); odo.next()) {
+            buffer[odo.offset()] += 1;
+        }
+        return buffer[0];
+    });
+    report("Odometer<" + type_name<Size_>() + ", 3>::next() [per element]", stepped / divisor, nested / divisor);
+
+    auto visited = time_per_op(inputs, [&](int extent) -> double {
+        const std::array<int, 3> start{ extent / 8, extent / 4, extent / 2 }, count{ extent / 2, extent / 2, extent / 4 };
+        sanisizer::Odometer<Size_> odo(std::vector<int>{ extent, extent, extent }, start, count);
+        odo.visit([&](Size_ o) -> void { buffer[o] += 1; });
+        return buffer[0];
+    });
+    report("Odometer<" + type_name<Size_>() + ">::visit() [per element]", visited / divisor, nested / divisor);
+}
+
+/*** Floats ***/
+
+template<typename Integer_>
+void benchmark_from_float() {
+    std::uniform_real_distribution<double> dist(0, 100);
+    std::vector<double> inputs(num_inputs);
+    for (auto& in : inputs) {
+        in = dist(rng);
+    }
+    compare(
+        "from_float<" + type_name<Integer_>() + ">(double)",
+        inputs,
+        [](double x) -> Integer_ { return sanisizer::from_float<Integer_>(x); },
+        [](double x) -> Integer_ { return static_cast<Integer_>(x); }
+    );
+}
+
+template<typename Integer_>
+void benchmark_from_float_bulk() {
+    struct Batch {
+        std::vector<double> input;
+        mutable std::vector<Integer_> output;
+    };
+    std::uniform_real_distribution<double> dist(0, 100);
+    std::vector<Batch> inputs(16);
+    for (auto& in : inputs) {
+        in.input.resize(num_inputs);
+        for (auto& x : in.input) {
+            x = dist(rng);
+        }
+        in.output.resize(num_inputs);
+    }
+
+    const double divisor = num_inputs;
+    auto looped = time_per_op(inputs, [](const Batch& b) -> Integer_ {
+        for (std::size_t i = 0; i < num_inputs; ++i) {
+            b.output[i] = sanisizer::from_float<Integer_>(b.input[i]);
+        }
+        return b.output.back();
+    });
+    auto bulk = time_per_op(inputs, [](const Batch& b) -> std::size_t {
+        return sanisizer::from_float_bulk(num_inputs, b.input.data(), b.output.data());
+    });
+    report("from_float_bulk<" + type_name<Integer_>() + ">(double) [per element]", bulk / divisor, looped / divisor);
+}
+
+template<typename Integer_>
+void benchmark_to_float() {
+    auto inputs = create_integers<Integer_>(100);
+    compare(
+        "to_float<double>(" + type_name<Integer_>() + ")",
+        inputs,
+        [](Integer_ x) -> double { return sanisizer::to_float<double>(x); },
+        [](Integer_ x) -> double { return static_cast<double>(x); }
+    );
+}
+
+template<typename ... Integers_>
+void benchmark_float_all(TypeList<Integers_...>) {
+    (benchmark_from_float<Integers_>(), ...);
+    (benchmark_to_float<Integers_>(), ...);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        num_passes = std::atoi(argv[1]);
+        if (num_passes <= 0) {
+            std::fprintf(stderr, "number of passes should be positive\n");
+            return 1;
+        }
+    }
+
+#if !defined(SANISIZER_ARITHMETIC_FORCE_MANUAL) && (defined(__GNUC__) || defined(__clang__))
+    std::printf("overflow checks in sum() and product(): compiler intrinsics\n\n");
+#else
+    std::printf("overflow checks in sum() and product(): portable fallback\n\n");
+#endif
+    std::printf("%-60s %10s %10s %8s\n", "benchmark", "checked", "unchecked", "ratio");
+    std::printf("%-60s %10s %10s %8s\n", "", "(ns/op)", "(ns/op)", "");
+
+    benchmark_cast_all(AllIntegers());
+    benchmark_cast_attested();
+    benchmark_cast_class();
+
+    benchmark_arithmetic_all(AllIntegers());
+    benchmark_arithmetic_attested();
+    benchmark_arithmetic_large();
+
+    benchmark_ranges<std::uint8_t>();
+    benchmark_ranges<std::uint32_t>();
+    benchmark_ranges<std::uint64_t>();
+
+    benchmark_accumulator<std::uint32_t>();
+    benchmark_accumulator<std::uint64_t>();
+
+    benchmark_create_for_overwrite();
+    benchmark_arena();
+
+    benchmark_nd_offset<std::size_t>();
+    benchmark_nd_offset<std::int64_t>();
+    benchmark_nd_offsets_bulk<std::size_t>();
+    benchmark_nd_offsets_bulk<std::int64_t>();
+    benchmark_odometer<std::size_t>();
+
+    benchmark_float_all(AllIntegers());
+    benchmark_from_float_bulk<std::int32_t>();
+    benchmark_from_float_bulk<std::uint64_t>();
+
+    return 0;
+}
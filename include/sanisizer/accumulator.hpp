@@ -0,0 +1,116 @@
+#ifndef SANISIZER_ACCUMULATOR_HPP
+#define SANISIZER_ACCUMULATOR_HPP
+
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "attest.hpp"
+#include "arithmetic.hpp"
+
+/**
+ * @file accumulator.hpp
+ * @brief Accumulate sums and products with a deferred overflow check.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Accumulate sums and products with a deferred overflow check.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ *
+ * Each addition or multiplication follows the same rules as `sum()` and `product()`, respectively.
+ * However, instead of throwing an error on overflow, the failure is recorded in a "sticky" flag that persists across all subsequent operations. 
+ * The flag is only checked when the final value is requested with `value()`.
+ * This avoids a throwing branch in every iteration of a loop, allowing the compiler to optimize (and possibly vectorize) the loop body.
+ *
+ * For example, to compute a linear offset from a set of indices and extents:
+ *
+ * ```cpp
+ * sanisizer::Accumulator<std::size_t> offset;
+ * for (std::size_t d = ndim; d > 0; --d) {
+ *     offset.multiply(extents[d - 1]).add(indices[d - 1]);
+ * }
+ * auto result = offset.value(); // throws if any operation overflowed.
+ * ```
+ */
+template<typename Dest_>
+class Accumulator {
+    static_assert(std::is_integral<Dest_>::value);
+    bool my_failed = false;
+    Dest_ my_value = 0;
+
+public:
+    /**
+     * Initialize the accumulator with a value of zero.
+     */
+    constexpr Accumulator() = default;
+
+    /**
+     * @tparam Value_ Integer type of the initial value.
+     * This may also be an `Attestation`.
+     * @param x Non-negative initial value.
+     * If this cannot be represented in `Dest_`, the overflow flag is set.
+     */
+    template<typename Value_>
+    constexpr Accumulator(Value_ x) : my_failed(cast_overflows<Dest_>(x)), my_value(static_cast<Dest_>(get_value(x))) {}
+
+public:
+    /**
+     * @tparam Value_ Integer type of the value to add.
+     * This may also be an `Attestation`.
+     * @param x Non-negative value to add to the current value.
+     * @return Reference to this `Accumulator`, with the overflow flag set if the sum overflows.
+     */
+    template<typename Value_>
+    constexpr Accumulator& add(Value_ x) {
+        my_value = get_value(sum_flagged<Dest_>(my_failed, my_value, x));
+        return *this;
+    }
+
+    /**
+     * @tparam Value_ Integer type of the value to multiply.
+     * This may also be an `Attestation`.
+     * @param x Non-negative value to multiply with the current value.
+     * @return Reference to this `Accumulator`, with the overflow flag set if the product overflows.
+     */
+    template<typename Value_>
+    constexpr Accumulator& multiply(Value_ x) {
+        my_value = get_value(product_flagged<Dest_>(my_failed, my_value, x));
+        return *this;
+    }
+
+public:
+    /**
+     * @return Whether an overflow occurred in any of the previous operations.
+     */
+    constexpr bool overflowed() const {
+        return my_failed;
+    }
+
+    /**
+     * @return The accumulated value.
+     * An error is raised if an overflow occurred in any of the previous operations.
+     */
+    constexpr Dest_ value() const {
+        if (my_failed) {
+            throw std::overflow_error("overflow detected in sanisizer::Accumulator");
+        }
+        return my_value;
+    }
+
+    /**
+     * @return The accumulated value, or no value if an overflow occurred in any of the previous operations.
+     */
+    constexpr std::optional<Dest_> try_value() const noexcept {
+        if (my_failed) {
+            return std::nullopt;
+        }
+        return my_value;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef SANISIZER_ARENA_HPP
+#define SANISIZER_ARENA_HPP
+
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+#include "attest.hpp"
+#include "cast.hpp"
+#include "arithmetic.hpp"
+#include "overwrite.hpp"
+
+/**
+ * @file arena.hpp
+ * @brief Bump allocation from a fixed-size arena.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Bump allocation from a fixed-size arena.
+ *
+ * Each allocation is served by aligning and advancing a pointer into a single buffer, and all allocations are released at once by `release()`.
+ * This is useful for workloads that create many small containers with the same lifetime, avoiding a call to `malloc()` for each container.
+ * All arithmetic on the bump pointer is checked with `align_up()` and `sum()`, so a corrupt size or alignment will throw an `std::overflow_error` rather than wrapping around.
+ * If the arena does not have enough space remaining, a `std::bad_alloc` is thrown.
+ *
+ * This class is a `std::pmr::memory_resource` so it can be used with the `std::pmr` containers.
+ * Alternatively, it can be used with regular containers via an `ArenaAllocator`.
+ */
+class Arena final : public std::pmr::memory_resource {
+public:
+    /**
+     * Create an arena that owns its buffer.
+     *
+     * @tparam Value_ Integer type of the capacity.
+     * @param capacity Non-negative capacity of the arena, in bytes.
+     */
+    template<typename Value_>
+    explicit Arena(Value_ capacity) :
+        my_owned(create_unique_for_overwrite<unsigned char>(capacity)),
+        my_buffer(my_owned.get()),
+        my_capacity(cast<std::size_t>(capacity))
+    {}
+
+    /**
+     * Create an arena from an existing buffer.
+     * The buffer should outlive the arena and any allocations from it.
+     *
+     * @param buffer Pointer to the start of the buffer.
+     * @param capacity Size of the buffer, in bytes.
+     */
+    Arena(void* buffer, std::size_t capacity) : my_buffer(static_cast<unsigned char*>(buffer)), my_capacity(capacity) {}
+
+    /**
+     * @cond
+     */
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    /**
+     * @endcond
+     */
+
+public:
+    /**
+     * @return Capacity of the arena, in bytes.
+     */
+    std::size_t capacity() const {
+        return my_capacity;
+    }
+
+    /**
+     * @return Number of bytes used by previous allocations, including any padding for alignment.
+     */
+    std::size_t used() const {
+        return my_used;
+    }
+
+    /**
+     * @return Number of bytes remaining in the arena.
+     */
+    std::size_t available() const {
+        return my_capacity - my_used;
+    }
+
+    /**
+     * Release all allocations at once, so that the entire capacity is available again.
+     * This is a constant-time operation that does not run any destructors.
+     */
+    void release() {
+        my_used = 0;
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> my_owned;
+    unsigned char* my_buffer;
+    std::size_t my_capacity;
+    std::size_t my_used = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        // These cannot overflow as they refer to addresses inside the buffer.
+        const auto base = reinterpret_cast<std::uintptr_t>(my_buffer);
+        const std::uintptr_t current = base + my_used;
+
+        const std::uintptr_t start = get_value(align_up<std::uintptr_t>(current, alignment));
+        const std::uintptr_t end = sum<std::uintptr_t>(start, bytes);
+        if (end - base > my_capacity) {
+            throw std::bad_alloc();
+        }
+
+        my_used = end - base;
+        return my_buffer + (start - base);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief Allocator that draws from an `Arena`.
+ *
+ * @tparam Type_ Type of the elements.
+ *
+ * This allows standard containers to use an `Arena` without the virtual dispatch of `std::pmr::polymorphic_allocator`.
+ * Deallocation is a no-op, as all memory is reclaimed by `Arena::release()`.
+ * The `max_size()` is set to the number of elements that can fit in the entire arena,
+ * so `create()`, `resize()` and `reserve()` will fail quickly for requests that cannot possibly be satisfied.
+ * Exhaustion of the remaining space is only reported by `allocate()`, which throws a `std::bad_alloc`.
+ */
+template<typename Type_>
+class ArenaAllocator {
+public:
+    /**
+     * Type of the elements.
+     */
+    typedef Type_ value_type;
+
+    /**
+     * @param arena The arena to allocate from.
+     * This should outlive the allocator and any containers using it.
+     */
+    ArenaAllocator(Arena& arena) noexcept : my_arena(&arena) {}
+
+    /**
+     * @tparam Other_ Type of the elements in the other allocator.
+     * @param other Allocator to copy the arena from.
+     */
+    template<typename Other_>
+    ArenaAllocator(const ArenaAllocator<Other_>& other) noexcept : my_arena(other.arena()) {}
+
+public:
+    /**
+     * @param n Number of elements to allocate.
+     * @return Pointer to storage for `n` elements.
+     * A `std::bad_array_new_length` is thrown if the number of bytes overflows, and a `std::bad_alloc` is thrown if the arena does not have enough space.
+     */
+    Type_* allocate(std::size_t n) {
+        const auto bytes = try_product<std::size_t>(n, sizeof(Type_));
+        if (!bytes.has_value()) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type_*>(my_arena->allocate(*bytes, alignof(Type_)));
+    }
+
+    /**
+     * Does nothing, see `Arena::release()` instead.
+     */
+    void deallocate(Type_*, std::size_t) noexcept {}
+
+    /**
+     * @return Maximum number of elements that could be allocated from an empty arena.
+     * This does not consider the space that is already in use, as containers expect `max_size()` to be constant,
+     * e.g., libstdc++'s `std::vector` clamps its new capacity to `max_size()` without checking that it can still hold the existing elements.
+     */
+    std::size_t max_size() const noexcept {
+        return my_arena->capacity() / sizeof(Type_);
+    }
+
+    /**
+     * @return Pointer to the arena.
+     */
+    Arena* arena() const noexcept {
+        return my_arena;
+    }
+
+private:
+    Arena* my_arena;
+};
+
+/**
+ * @cond
+ */
+template<typename Left_, typename Right_>
+bool operator==(const ArenaAllocator<Left_>& left, const ArenaAllocator<Right_>& right) noexcept {
+    return left.arena() == right.arena();
+}
+
+template<typename Left_, typename Right_>
+bool operator!=(const ArenaAllocator<Left_>& left, const ArenaAllocator<Right_>& right) noexcept {
+    return left.arena() != right.arena();
+}
+/**
+ * @endcond
+ */
+
+}
+
+#endif
@@ -4,6 +4,10 @@
 #include <limits>
 #include <type_traits>
 #include <stdexcept>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
 
 #include "attest.hpp"
 #include "utils.hpp"
@@ -18,6 +22,36 @@ namespace sanisizer {
 /**
  * @cond
  */
+// Using the compiler intrinsics by default, as these compile down to a single flag test after the arithmetic.
+// The portable fallbacks can be forced with the SANISIZER_ARITHMETIC_FORCE_MANUAL macro.
+template<typename Dest_>
+constexpr bool add_overflows(Dest_ left, Dest_ right, Dest_& output) {
+#if !defined(SANISIZER_ARITHMETIC_FORCE_MANUAL) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_add_overflow(left, right, &output);
+#else
+    constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
+    if (static_cast<Dest_>(dest_maxed - left) < right) {
+        return true;
+    }
+    output = left + right;
+    return false;
+#endif
+}
+
+template<typename Dest_>
+constexpr bool mul_overflows(Dest_ left, Dest_ right, Dest_& output) {
+#if !defined(SANISIZER_ARITHMETIC_FORCE_MANUAL) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_mul_overflow(left, right, &output);
+#else
+    constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
+    if (left && static_cast<Dest_>(dest_maxed / left) < right) {
+        return true;
+    }
+    output = left * right;
+    return false;
+#endif
+}
+
 template<typename Dest_, typename First_, typename Second_>
 constexpr bool needs_sum_check() {
     constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
@@ -31,6 +65,22 @@ constexpr bool needs_sum_check() {
     }
 }
 
+// Lower bound on the sum, to be propagated to the output Attestation.
+// If this would overflow, any sum would have already thrown, so we just cap it at the maximum of Dest_.
+template<typename Dest_, typename First_, typename Second_>
+constexpr Dest_ sum_min() {
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    constexpr auto first_min = as_unsigned(get_min<First_>());
+    constexpr auto second_min = as_unsigned(get_min<Second_>());
+    if constexpr(first_min > dest_maxed) {
+        return dest_maxed;
+    } else if constexpr(second_min > dest_maxed - first_min) {
+        return dest_maxed;
+    } else {
+        return static_cast<Dest_>(first_min) + static_cast<Dest_>(second_min);
+    }
+}
+
 template<typename Dest_, typename First_, typename Second_>
 constexpr auto sum_protected(First_ first, Second_ second) {
     check_overflow<Dest_>(first);
@@ -42,14 +92,15 @@ constexpr auto sum_protected(First_ first, Second_ second) {
     if constexpr(needs_sum_check<Dest_, First_, Second_>()) {
         static_assert(std::is_integral<Dest_>::value);
         constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
-        if (static_cast<Dest_>(dest_maxed - first_val) < second_val) {
+        Dest_ output = 0;
+        if (add_overflows(first_val, second_val, output)) {
             throw std::overflow_error("overflow detected in sanisizer::sum");
         }
-        return Attestation<Dest_, dest_maxed>(static_cast<Dest_>(first_val + second_val));
+        return Attestation<Dest_, dest_maxed, sum_min<Dest_, First_, Second_>()>(output);
 
     } else {
         constexpr Dest_ maxsum = static_cast<Dest_>(get_max<First_>()) + static_cast<Dest_>(get_max<Second_>());
-        return Attestation<Dest_, maxsum>(static_cast<Dest_>(first_val + second_val));
+        return Attestation<Dest_, maxsum, sum_min<Dest_, First_, Second_>()>(static_cast<Dest_>(first_val + second_val));
     }
 }
 
@@ -59,6 +110,36 @@ constexpr auto sum_protected(First_ first, Second_ second, Args_... more) {
     return sum_protected<Dest_>(subsum, more...);
 }
 
+// Same as sum_protected(), but any failure is recorded in 'failed' instead of throwing.
+// This is done without branching so that it can be used in vectorizable loops.
+// After a failure, the output value is meaningless and is just set to zero, so the minimum is not propagated.
+template<typename Dest_, typename First_, typename Second_>
+constexpr auto sum_flagged(bool& failed, First_ first, Second_ second) {
+    failed |= cast_overflows<Dest_>(first);
+    const Dest_ first_val = get_value(first);
+
+    failed |= cast_overflows<Dest_>(second);
+    const Dest_ second_val = get_value(second);
+
+    if constexpr(needs_sum_check<Dest_, First_, Second_>()) {
+        static_assert(std::is_integral<Dest_>::value);
+        constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
+        Dest_ output = 0;
+        failed |= add_overflows(first_val, second_val, output);
+        return Attestation<Dest_, dest_maxed>(failed ? 0 : output);
+
+    } else {
+        constexpr Dest_ maxsum = static_cast<Dest_>(get_max<First_>()) + static_cast<Dest_>(get_max<Second_>());
+        return Attestation<Dest_, maxsum>(static_cast<Dest_>(first_val + second_val));
+    }
+}
+
+template<typename Dest_, typename First_, typename Second_, typename ... Args_>
+constexpr auto sum_flagged(bool& failed, First_ first, Second_ second, Args_... more) {
+    const auto subsum = sum_flagged<Dest_>(failed, first, second); 
+    return sum_flagged<Dest_>(failed, subsum, more...);
+}
+
 template<typename Dest_, typename First_, typename Second_>
 constexpr Dest_ sum_unprotected(First_ first, Second_ second) {
     static_assert(std::is_integral<Dest_>::value);
@@ -115,6 +196,138 @@ constexpr Dest_ sum_unsafe(First_ first, Args_... more) {
     return sum_unprotected<Dest_>(first, more...);
 }
 
+/**
+ * Non-throwing version of `sum()`, for use in `noexcept` code or where overflow is an expected outcome.
+ * Checks are skipped at compile time under the same conditions as `sum()`, in which case this is as cheap as regular addition.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam First_ Integer type of the first value.
+ * This may also be an `Attestation`.
+ * @tparam Args_ Integer types of additional values.
+ * Any number of these may also be `Attestation`s.
+ *
+ * @param first First non-negative value to add.
+ * @param more Additional non-negative values to add.
+ *
+ * @return Sum of all arguments as a `Dest_`, or no value if an overflow would occur.
+ */
+template<typename Dest_, typename First_, typename ... Args_>
+constexpr std::optional<Dest_> try_sum(First_ first, Args_... more) noexcept {
+    bool failed = false;
+    const auto output = sum_flagged<Dest_>(failed, first, more...);
+    if (failed) {
+        return std::nullopt;
+    }
+    return get_value(output);
+}
+
+/**
+ * @cond
+ */
+template<typename Dest_, typename Iterator_>
+Dest_ sum_range_scalar(Iterator_ begin, Iterator_ end) {
+    Dest_ output = 0;
+    for (; begin != end; ++begin) {
+        output = get_value(sum_protected<Dest_>(output, *begin));
+    }
+    return output;
+}
+
+template<typename Dest_, bool track_carry_, typename Iterator_, typename Length_>
+bool sum_range_overflows(Iterator_ begin, Length_ n, Dest_& output) {
+    typedef I<decltype(*begin)> Value;
+    constexpr auto value_maxed = as_unsigned(get_max<Value>());
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    typedef std::common_type_t<std::uintmax_t, I<decltype(dest_maxed)> > Partial;
+
+    // The loop is free of branches so that the compiler can vectorize it.
+    // Invalid inputs are detected by checking for bits beyond the maximum of Dest_ (always of the form 2^k - 1),
+    // while wrap-around of the partial sum is detected by comparing it to the newly added value.
+    Partial partial = 0;
+    Partial carry = 0;
+    I<decltype(value_maxed)> excess = 0;
+    for (Length_ i = 0; i < n; ++i) {
+        const auto val = as_unsigned(get_value(begin[i]));
+        if constexpr(value_maxed > dest_maxed) {
+            excess |= val & ~static_cast<I<decltype(val)> >(dest_maxed);
+        }
+        partial += static_cast<Partial>(val);
+        if constexpr(track_carry_) {
+            carry |= static_cast<Partial>(partial < static_cast<Partial>(val));
+        }
+    }
+
+    output = partial;
+    return excess || carry || partial > dest_maxed;
+}
+
+template<typename Dest_, typename Iterator_>
+Dest_ sum_range_vectorized(Iterator_ begin, Iterator_ end) {
+    typedef I<decltype(*begin)> Value;
+    constexpr auto value_maxed = as_unsigned(get_max<Value>());
+    if constexpr(value_maxed == 0) {
+        return 0;
+
+    } else {
+        static_assert(std::is_integral<Dest_>::value);
+        constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+        typedef std::common_type_t<std::uintmax_t, I<decltype(dest_maxed)> > Partial;
+
+        // Maximum length of a range that can be summed in a Partial without any possibility of wrap-around,
+        // given that each element will also be checked for whether it is representable in Dest_.
+        // If the range is shorter, we can skip the tracking of the carries.
+        constexpr Partial element_maxed = (value_maxed > dest_maxed ? dest_maxed : value_maxed);
+        constexpr Partial safe_length = std::numeric_limits<Partial>::max() / element_maxed;
+
+        const auto n = as_unsigned(end - begin);
+        Dest_ output = 0;
+        bool failed;
+        if (n <= safe_length) {
+            failed = sum_range_overflows<Dest_, false>(begin, n, output);
+        } else {
+            failed = sum_range_overflows<Dest_, true>(begin, n, output);
+        }
+
+        if (failed) {
+            throw std::overflow_error("overflow detected in sanisizer::sum_range");
+        }
+        return output;
+    }
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Add a range of non-negative values, checking for overflow in the destination type.
+ * This is typically used to compute the total size of many smaller arrays, e.g., the number of non-zero elements across chunks.
+ *
+ * For random-access iterators, the range is summed in a single pass without any branches, allowing the compiler to vectorize the loop.
+ * A single overflow check is then performed at the end.
+ * If the maximum of the element type multiplied by the length of the range fits in the widest unsigned integer type, the partial sum cannot wrap around;
+ * otherwise, any wrap-around is tracked within the loop, which is slightly more expensive.
+ * For other iterators, each element is added to a running total with the same checks as `sum()`.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Iterator_ Forward iterator that dereferences to an integer.
+ * The iterator may also dereference to an `Attestation`.
+ *
+ * @param begin Start of the range of non-negative values to add.
+ * @param end End of the range.
+ *
+ * @return Sum of all values as a `Dest_`.
+ * An error is raised if an overflow would occur.
+ */
+template<typename Dest_, typename Iterator_>
+Dest_ sum_range(Iterator_ begin, Iterator_ end) {
+    typedef typename std::iterator_traits<Iterator_>::iterator_category Category;
+    if constexpr(std::is_base_of<std::random_access_iterator_tag, Category>::value) {
+        return sum_range_vectorized<Dest_>(begin, end);
+    } else {
+        return sum_range_scalar<Dest_>(begin, end);
+    }
+}
+
 /**
  * @cond
  */
@@ -133,6 +346,23 @@ constexpr bool needs_product_check() {
     }
 }
 
+// Lower bound on the product, capped at the maximum of Dest_ for the same reasons as sum_min().
+template<typename Dest_, typename First_, typename Second_>
+constexpr Dest_ product_min() {
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    constexpr auto first_min = as_unsigned(get_min<First_>());
+    constexpr auto second_min = as_unsigned(get_min<Second_>());
+    if constexpr(first_min == 0 || second_min == 0) {
+        return 0;
+    } else if constexpr(first_min > dest_maxed) {
+        return dest_maxed;
+    } else if constexpr(second_min > dest_maxed / first_min) {
+        return dest_maxed;
+    } else {
+        return static_cast<Dest_>(first_min) * static_cast<Dest_>(second_min);
+    }
+}
+
 template<typename Dest_, typename First_, typename Second_>
 constexpr auto product_protected(First_ first, Second_ second) {
     check_overflow<Dest_>(first);
@@ -144,14 +374,15 @@ constexpr auto product_protected(First_ first, Second_ second) {
     if constexpr(needs_product_check<Dest_, First_, Second_>()) {
         static_assert(std::is_integral<Dest_>::value);
         constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
-        if (first_val && static_cast<Dest_>(dest_maxed / first_val) < second_val) {
+        Dest_ output = 0;
+        if (mul_overflows(first_val, second_val, output)) {
             throw std::overflow_error("overflow detected in sanisizer::product");
         }
-        return Attestation<Dest_, dest_maxed>(static_cast<Dest_>(first_val * second_val));
+        return Attestation<Dest_, dest_maxed, product_min<Dest_, First_, Second_>()>(output);
 
     } else {
         constexpr Dest_ maxprod = static_cast<Dest_>(get_max<First_>()) * static_cast<Dest_>(get_max<Second_>());
-        return Attestation<Dest_, maxprod>(static_cast<Dest_>(first_val * second_val));
+        return Attestation<Dest_, maxprod, product_min<Dest_, First_, Second_>()>(static_cast<Dest_>(first_val * second_val));
     }
 }
 
@@ -161,6 +392,34 @@ constexpr auto product_protected(First_ first, Second_ second, Args_... more) {
     return product_protected<Dest_>(subproduct, more...);
 }
 
+// Same as product_protected(), but any failure is recorded in 'failed' instead of throwing.
+template<typename Dest_, typename First_, typename Second_>
+constexpr auto product_flagged(bool& failed, First_ first, Second_ second) {
+    failed |= cast_overflows<Dest_>(first);
+    const Dest_ first_val = get_value(first);
+
+    failed |= cast_overflows<Dest_>(second);
+    const Dest_ second_val = get_value(second);
+
+    if constexpr(needs_product_check<Dest_, First_, Second_>()) {
+        static_assert(std::is_integral<Dest_>::value);
+        constexpr Dest_ dest_maxed = std::numeric_limits<Dest_>::max();
+        Dest_ output = 0;
+        failed |= mul_overflows(first_val, second_val, output);
+        return Attestation<Dest_, dest_maxed>(failed ? 0 : output);
+
+    } else {
+        constexpr Dest_ maxprod = static_cast<Dest_>(get_max<First_>()) * static_cast<Dest_>(get_max<Second_>());
+        return Attestation<Dest_, maxprod>(static_cast<Dest_>(first_val * second_val));
+    }
+}
+
+template<typename Dest_, typename First_, typename Second_, typename ... Args_>
+constexpr auto product_flagged(bool& failed, First_ first, Second_ second, Args_... more) {
+    const auto subproduct = product_flagged<Dest_>(failed, first, second);
+    return product_flagged<Dest_>(failed, subproduct, more...);
+}
+
 template<typename Dest_, typename First_, typename Second_>
 constexpr Dest_ product_unprotected(First_ left, Second_ right) {
     static_assert(std::is_integral<Dest_>::value);
@@ -220,6 +479,477 @@ constexpr Dest_ product_unsafe(First_ first, Args_... more) {
     return product_unprotected<Dest_>(first, more...);
 }
 
+/**
+ * Non-throwing version of `product()`, for use in `noexcept` code or where overflow is an expected outcome.
+ * Checks are skipped at compile time under the same conditions as `product()`, in which case this is as cheap as regular multiplication.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam First_ Integer type of the first value.
+ * This may also be an `Attestation`.
+ * @tparam Args_ Integer types of additional values.
+ * Any number of these may also be `Attestation`s.
+ *
+ * @param first Non-negative value to multiply.
+ * @param more Additional non-negative values to multiply.
+ *
+ * @return Product of all arguments as a `Dest_`, or no value if an overflow would occur (including if any argument cannot be represented in `Dest_`).
+ */
+template<typename Dest_, typename First_, typename ... Args_>
+constexpr std::optional<Dest_> try_product(First_ first, Args_... more) noexcept {
+    bool failed = false;
+    const auto output = product_flagged<Dest_>(failed, first, more...);
+    if (failed) {
+        return std::nullopt;
+    }
+    return get_value(output);
+}
+
+/**
+ * Multiply a range of non-negative values, checking for overflow in the destination type.
+ * This is typically used to compute the size of a flattened N-dimensional array where the number of dimensions is only known at run-time.
+ *
+ * As in `product()`, this function also checks that each input value can be cast to `Dest_`.
+ * Once a zero is encountered, no further multiplications are performed, though the remaining values are still checked for castability.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Iterator_ Forward iterator that dereferences to an integer.
+ * The iterator may also dereference to an `Attestation`.
+ *
+ * @param begin Start of the range of non-negative values to multiply.
+ * @param end End of the range.
+ *
+ * @return Product of all values as a `Dest_`.
+ * This is equal to 1 for an empty range.
+ * An error is raised if an overflow would occur.
+ */
+template<typename Dest_, typename Iterator_>
+constexpr Dest_ product_range(Iterator_ begin, Iterator_ end) {
+    static_assert(std::is_integral<Dest_>::value);
+
+    Dest_ output = 1;
+    for (; begin != end; ++begin) {
+        check_overflow<Dest_>(*begin);
+        const Dest_ val = get_value(*begin);
+        if (val == 0) {
+            output = 0;
+            ++begin;
+            break;
+        }
+        if (mul_overflows(output, val, output)) {
+            throw std::overflow_error("overflow detected in sanisizer::product_range");
+        }
+    }
+
+    for (; begin != end; ++begin) {
+        check_overflow<Dest_>(*begin);
+    }
+
+    return output;
+}
+
+
+/**
+ * @cond
+ */
+template<typename First_, typename Second_>
+constexpr bool needs_difference_check() {
+    return as_unsigned(get_min<First_>()) < as_unsigned(get_max<Second_>());
+}
+
+template<typename First_, typename Second_>
+using CommonUnsigned = std::common_type_t<I<decltype(as_unsigned(get_max<First_>()))>, I<decltype(as_unsigned(get_max<Second_>()))> >;
+
+// Upper and lower bounds on the difference, in the common unsigned type of the inputs.
+// If every difference would be negative, we just set the bounds to zero as an error would always be raised anyway.
+template<typename First_, typename Second_>
+constexpr auto difference_max() {
+    typedef CommonUnsigned<First_, Second_> Unsigned;
+    constexpr Unsigned first_maxed = as_unsigned(get_max<First_>());
+    constexpr Unsigned second_min = as_unsigned(get_min<Second_>());
+    if constexpr(first_maxed < second_min) {
+        return static_cast<Unsigned>(0);
+    } else {
+        return static_cast<Unsigned>(first_maxed - second_min);
+    }
+}
+
+template<typename First_, typename Second_>
+constexpr auto difference_min() {
+    typedef CommonUnsigned<First_, Second_> Unsigned;
+    constexpr Unsigned first_min = as_unsigned(get_min<First_>());
+    constexpr Unsigned second_maxed = as_unsigned(get_max<Second_>());
+    if constexpr(first_min < second_maxed) {
+        return static_cast<Unsigned>(0);
+    } else {
+        return static_cast<Unsigned>(first_min - second_maxed);
+    }
+}
+
+template<typename Dest_, typename First_, typename Second_>
+constexpr auto difference_protected(First_ first, Second_ second) {
+    static_assert(std::is_integral<Dest_>::value);
+    typedef CommonUnsigned<First_, Second_> Unsigned;
+    const Unsigned first_val = as_unsigned(get_value(first));
+    const Unsigned second_val = as_unsigned(get_value(second));
+
+    if constexpr(needs_difference_check<First_, Second_>()) {
+        if (first_val < second_val) {
+            throw std::out_of_range("negative result in sanisizer::difference");
+        }
+    }
+
+    constexpr Unsigned maxdiff = difference_max<First_, Second_>();
+    constexpr Unsigned mindiff = difference_min<First_, Second_>();
+    const Attestation<Unsigned, maxdiff, mindiff> output(static_cast<Unsigned>(first_val - second_val));
+    check_overflow<Dest_>(output);
+    return Attestation<Dest_, cap_bound<Dest_>(maxdiff), cap_bound<Dest_>(mindiff)>(output.value);
+}
+
+// Same as difference_protected(), but any failure is recorded in 'failed' instead of throwing.
+// After a failure, the output value is meaningless and is just set to zero, so the minimum is not propagated.
+template<typename Dest_, typename First_, typename Second_>
+constexpr auto difference_flagged(bool& failed, First_ first, Second_ second) {
+    static_assert(std::is_integral<Dest_>::value);
+    typedef CommonUnsigned<First_, Second_> Unsigned;
+    const Unsigned first_val = as_unsigned(get_value(first));
+    const Unsigned second_val = as_unsigned(get_value(second));
+
+    if constexpr(needs_difference_check<First_, Second_>()) {
+        failed |= (first_val < second_val);
+    }
+
+    constexpr Unsigned maxdiff = difference_max<First_, Second_>();
+    const Unsigned diff = static_cast<Unsigned>(first_val - second_val);
+    failed |= cast_overflows<Dest_>(Attestation<Unsigned, maxdiff>(failed ? 0 : diff));
+    return Attestation<Dest_, cap_bound<Dest_>(maxdiff)>(failed ? 0 : static_cast<Dest_>(diff));
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Subtract one non-negative value from another, checking that the result is non-negative and can be represented in the destination type.
+ * This is typically used to compute the remaining length of a range or the size of a window.
+ *
+ * The check for a negative result is skipped at compile time if the minimum of `First_` is known to be no less than the maximum of `Second_`, e.g., from an `Attestation`.
+ * Similarly, the check for overflow in `Dest_` is skipped if the maximum of `First_` minus the minimum of `Second_` can always be represented in `Dest_`.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam First_ Integer type of the first value.
+ * This may also be an `Attestation`.
+ * @tparam Second_ Integer type of the second value.
+ * This may also be an `Attestation`.
+ *
+ * @param first Non-negative value to subtract from.
+ * @param second Non-negative value to subtract.
+ *
+ * @return Difference between `first` and `second` as a `Dest_`.
+ * An error is raised if `second` is greater than `first` or an overflow would occur.
+ */
+template<typename Dest_, typename First_, typename Second_>
+constexpr Dest_ difference(First_ first, Second_ second) {
+    return get_value(difference_protected<Dest_>(first, second));
+}
+
+/**
+ * Non-throwing version of `difference()`, for use in `noexcept` code or where a negative result is an expected outcome.
+ * Checks are skipped at compile time under the same conditions as `difference()`, in which case this is as cheap as regular subtraction.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam First_ Integer type of the first value.
+ * This may also be an `Attestation`.
+ * @tparam Second_ Integer type of the second value.
+ * This may also be an `Attestation`.
+ *
+ * @param first Non-negative value to subtract from.
+ * @param second Non-negative value to subtract.
+ *
+ * @return Difference between `first` and `second` as a `Dest_`, or no value if `second` is greater than `first` or an overflow would occur.
+ */
+template<typename Dest_, typename First_, typename Second_>
+constexpr std::optional<Dest_> try_difference(First_ first, Second_ second) noexcept {
+    bool failed = false;
+    const auto output = difference_flagged<Dest_>(failed, first, second);
+    if (failed) {
+        return std::nullopt;
+    }
+    return get_value(output);
+}
+
+
+/**
+ * @cond
+ */
+template<typename Divisor_>
+constexpr bool needs_divisor_check() {
+    return get_min<Divisor_>() == 0;
+}
+
+// Bounds on the divisor, which are at least 1 as a zero divisor will raise an error anyway.
+template<typename Divisor_>
+constexpr auto divisor_min() {
+    constexpr auto raw = as_unsigned(get_min<Divisor_>());
+    return (raw == 0 ? static_cast<I<decltype(raw)> >(1) : raw);
+}
+
+template<typename Divisor_>
+constexpr auto divisor_max() {
+    constexpr auto raw = as_unsigned(get_max<Divisor_>());
+    return (raw == 0 ? static_cast<I<decltype(raw)> >(1) : raw);
+}
+
+template<bool ceiling_, typename Unsigned_>
+constexpr Unsigned_ divide_unsigned(Unsigned_ num, Unsigned_ den) {
+    // The remainder should be computed by the same division instruction, so this is cheaper than (num + den - 1) / den.
+    Unsigned_ quotient = num / den;
+    if constexpr(ceiling_) {
+        quotient += static_cast<Unsigned_>(num % den != 0);
+    }
+    return quotient;
+}
+
+template<typename Dest_, bool ceiling_, typename Numerator_, typename Divisor_>
+constexpr auto divide_protected(Numerator_ num, Divisor_ den) {
+    static_assert(std::is_integral<Dest_>::value);
+    typedef CommonUnsigned<Numerator_, Divisor_> Unsigned;
+    const Unsigned num_val = as_unsigned(get_value(num));
+    const Unsigned den_val = as_unsigned(get_value(den));
+
+    if constexpr(needs_divisor_check<Divisor_>()) {
+        if (den_val == 0) {
+            throw std::domain_error("division by zero in sanisizer::divide");
+        }
+    }
+
+    constexpr Unsigned maxquo = divide_unsigned<ceiling_, Unsigned>(as_unsigned(get_max<Numerator_>()), divisor_min<Divisor_>());
+    constexpr Unsigned minquo = divide_unsigned<ceiling_, Unsigned>(as_unsigned(get_min<Numerator_>()), divisor_max<Divisor_>());
+    const Attestation<Unsigned, maxquo, minquo> output(divide_unsigned<ceiling_>(num_val, den_val));
+    check_overflow<Dest_>(output);
+    return Attestation<Dest_, cap_bound<Dest_>(maxquo), cap_bound<Dest_>(minquo)>(output.value);
+}
+
+template<typename Dest_, typename Numerator_, typename Divisor_>
+constexpr auto modulo_protected(Numerator_ num, Divisor_ den) {
+    static_assert(std::is_integral<Dest_>::value);
+    typedef CommonUnsigned<Numerator_, Divisor_> Unsigned;
+    const Unsigned num_val = as_unsigned(get_value(num));
+    const Unsigned den_val = as_unsigned(get_value(den));
+
+    if constexpr(needs_divisor_check<Divisor_>()) {
+        if (den_val == 0) {
+            throw std::domain_error("division by zero in sanisizer::modulo");
+        }
+    }
+
+    // Remainder is no greater than the numerator and less than the divisor.
+    constexpr Unsigned num_maxed = as_unsigned(get_max<Numerator_>());
+    constexpr Unsigned den_maxed = as_unsigned(get_max<Divisor_>());
+    constexpr Unsigned maxrem = (den_maxed == 0 ? 0 : (num_maxed < den_maxed ? num_maxed : static_cast<Unsigned>(den_maxed - 1)));
+    const Attestation<Unsigned, maxrem> output(static_cast<Unsigned>(num_val % den_val));
+    check_overflow<Dest_>(output);
+    return Attestation<Dest_, cap_bound<Dest_>(maxrem)>(output.value);
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Divide one non-negative value by another, rounding down.
+ * The quotient can never overflow, but it is still checked for whether it can be represented in `Dest_`.
+ *
+ * The check for a zero divisor is skipped at compile time if the minimum of `Divisor_` is known to be positive, e.g., from an `Attestation`.
+ * The check for overflow in `Dest_` is skipped if the maximum of `Numerator_` divided by the minimum of `Divisor_` can always be represented in `Dest_`.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Numerator_ Integer type of the numerator.
+ * This may also be an `Attestation`.
+ * @tparam Divisor_ Integer type of the divisor.
+ * This may also be an `Attestation`.
+ *
+ * @param num Non-negative numerator.
+ * @param den Positive divisor.
+ *
+ * @return Quotient as an `Attestation` of a `Dest_`.
+ * This attests to the bounds of the quotient, based on the bounds of `Numerator_` and `Divisor_`, allowing subsequent casts to skip their checks. 
+ * An error is raised if `den` is zero or an overflow would occur.
+ */
+template<typename Dest_, typename Numerator_, typename Divisor_>
+constexpr auto divide(Numerator_ num, Divisor_ den) {
+    return divide_protected<Dest_, false>(num, den);
+}
+
+/**
+ * Divide one non-negative value by another, rounding up.
+ * This is typically used to compute the number of blocks of size `den` that are required to cover `num` elements.
+ * Unlike the usual `(num + den - 1) / den`, this will not overflow for large `num`.
+ *
+ * Checks are skipped at compile time under the same conditions as `divide()`.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Numerator_ Integer type of the numerator.
+ * This may also be an `Attestation`.
+ * @tparam Divisor_ Integer type of the divisor.
+ * This may also be an `Attestation`.
+ *
+ * @param num Non-negative numerator.
+ * @param den Positive divisor.
+ *
+ * @return Quotient, rounded up, as an `Attestation` of a `Dest_`.
+ * This attests to the bounds of the quotient, based on the bounds of `Numerator_` and `Divisor_`, allowing subsequent casts to skip their checks. 
+ * An error is raised if `den` is zero or an overflow would occur.
+ */
+template<typename Dest_, typename Numerator_, typename Divisor_>
+constexpr auto ceil_divide(Numerator_ num, Divisor_ den) {
+    return divide_protected<Dest_, true>(num, den);
+}
+
+/**
+ * Compute the remainder after dividing one non-negative value by another.
+ *
+ * The check for a zero divisor is skipped at compile time if the minimum of `Divisor_` is known to be positive, e.g., from an `Attestation`.
+ * The check for overflow in `Dest_` is skipped if the smaller of the maximum of `Numerator_` and the maximum of `Divisor_` (minus 1) can always be represented in `Dest_`.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Numerator_ Integer type of the numerator.
+ * This may also be an `Attestation`.
+ * @tparam Divisor_ Integer type of the divisor.
+ * This may also be an `Attestation`.
+ *
+ * @param num Non-negative numerator.
+ * @param den Positive divisor.
+ *
+ * @return Remainder as an `Attestation` of a `Dest_`.
+ * This attests to the maximum of the remainder, allowing subsequent casts to skip their checks. 
+ * An error is raised if `den` is zero or an overflow would occur.
+ */
+template<typename Dest_, typename Numerator_, typename Divisor_>
+constexpr auto modulo(Numerator_ num, Divisor_ den) {
+    return modulo_protected<Dest_>(num, den);
+}
+
+
+/**
+ * @cond
+ */
+// Round up x to the nearest multiple of 'alignment', capping at the largest multiple that fits in Dest_.
+// This is only used to compute compile-time bounds.
+template<typename Dest_, typename Value_>
+constexpr Dest_ align_up_bound(Value_ x, Value_ alignment) {
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    const auto largest = dest_maxed - dest_maxed % alignment;
+    if (x > largest) {
+        return largest;
+    }
+    const Value_ rem = x % alignment;
+    return (rem == 0 ? x : x + (alignment - rem));
+}
+
+template<typename Dest_, typename Value_, typename Alignment_>
+constexpr auto align_up_protected(Value_ n, Alignment_ alignment) {
+    static_assert(std::is_integral<Dest_>::value);
+    check_overflow<Dest_>(n);
+    const Dest_ val = get_value(n);
+    check_overflow<Dest_>(alignment);
+    const Dest_ align = get_value(alignment);
+
+    if constexpr(needs_divisor_check<Alignment_>()) {
+        if (align == 0) {
+            throw std::domain_error("zero alignment in sanisizer::align_up");
+        }
+    }
+
+    // Everything is capped at the maximum of Dest_, as larger values would have failed the casts above.
+    typedef I<decltype(as_unsigned(std::numeric_limits<Dest_>::max()))> Unsigned;
+    constexpr Unsigned value_maxed = cap_bound<Dest_>(as_unsigned(get_max<Value_>()));
+    constexpr Unsigned value_min = cap_bound<Dest_>(as_unsigned(get_min<Value_>()));
+    constexpr Unsigned align_maxed = cap_bound<Dest_>(divisor_max<Alignment_>());
+    constexpr Unsigned align_min = cap_bound<Dest_>(divisor_min<Alignment_>());
+
+    // If the alignment is known at compile time, we can compute tight bounds on the output.
+    // Otherwise, we fall back to the loose bound of 'n + alignment - 1'.
+    constexpr Unsigned dest_maxed = std::numeric_limits<Dest_>::max();
+    constexpr bool fixed_alignment = (align_min == align_maxed);
+    constexpr bool needs_check = (
+        fixed_alignment ?
+            value_maxed > dest_maxed - dest_maxed % align_maxed :
+            value_maxed > dest_maxed - (align_maxed - 1)
+    );
+    constexpr Unsigned maxout = (
+        fixed_alignment ?
+            align_up_bound<Dest_, Unsigned>(value_maxed, align_maxed) :
+            (needs_check ? dest_maxed : static_cast<Unsigned>(value_maxed + (align_maxed - 1)))
+    );
+    constexpr Unsigned minout = (fixed_alignment ? align_up_bound<Dest_, Unsigned>(value_min, align_min) : value_min);
+
+    // The padding is computed without branches, and the remainder should be a cheap mask for compile-time powers of two.
+    const Dest_ rem = val % align;
+    const Dest_ pad = (rem == 0 ? 0 : align - rem);
+    Dest_ output = 0;
+    if constexpr(needs_check) {
+        if (add_overflows(val, pad, output)) {
+            throw std::overflow_error("overflow detected in sanisizer::align_up");
+        }
+    } else {
+        output = val + pad;
+    }
+
+    return Attestation<Dest_, static_cast<Dest_>(maxout), static_cast<Dest_>(minout)>(output);
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Round up a non-negative value to the nearest multiple of the alignment, checking for overflow in the destination type.
+ * This is typically used to pad the size of a buffer to a multiple of the SIMD register width or page size.
+ * Unlike the usual `(n + alignment - 1) / alignment * alignment`, this will not overflow for large `n`.
+ *
+ * The check for overflow is skipped at compile time if the maximum of `Value_` plus the maximum of `Alignment_` (minus 1) can always be represented in `Dest_`.
+ * The check for a zero alignment is skipped at compile time if the minimum of `Alignment_` is known to be positive, e.g., from an `Attestation`.
+ * If the alignment is known at compile time, the other overload of this function should be used instead.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Value_ Integer type of the input value.
+ * This may also be an `Attestation`.
+ * @tparam Alignment_ Integer type of the alignment.
+ * This may also be an `Attestation`.
+ *
+ * @param n Non-negative value to be rounded up.
+ * @param alignment Positive alignment.
+ * This does not need to be a power of two.
+ *
+ * @return `n` rounded up to the nearest multiple of `alignment`, as an `Attestation` of a `Dest_`.
+ * This attests to the bounds of the result, allowing subsequent casts (e.g., in `create()`) to skip their checks.
+ * An error is raised if `alignment` is zero or an overflow would occur.
+ */
+template<typename Dest_, typename Value_, typename Alignment_>
+constexpr auto align_up(Value_ n, Alignment_ alignment) {
+    return align_up_protected<Dest_>(n, alignment);
+}
+
+/**
+ * Overload of `align_up()` for an alignment that is known at compile time.
+ * The output bounds are tighter, as the maximum is the maximum of `Value_` rounded up to a multiple of `alignment_`.
+ * The rounding itself is also cheaper as the compiler can use a bit mask if `alignment_` is a power of two.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam alignment_ Positive alignment.
+ * This should be representable in `Dest_`.
+ * @tparam Value_ Integer type of the input value.
+ * This may also be an `Attestation`.
+ *
+ * @param n Non-negative value to be rounded up.
+ *
+ * @return `n` rounded up to the nearest multiple of `alignment_`, as an `Attestation` of a `Dest_`.
+ * An error is raised if an overflow would occur.
+ */
+template<typename Dest_, std::size_t alignment_, typename Value_>
+constexpr auto align_up(Value_ n) {
+    static_assert(alignment_ > 0);
+    static_assert(alignment_ <= as_unsigned(std::numeric_limits<Dest_>::max()));
+    return align_up_protected<Dest_>(n, Attestation<Dest_, alignment_, alignment_>(alignment_));
+}
+
 }
 
 #endif
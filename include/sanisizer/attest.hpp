@@ -21,22 +21,28 @@ namespace sanisizer {
  * @tparam Integer_ Type of the integer.
  * @tparam max_ Maximum value of the integer, known at compile time.
  * This should be non-negative.
+ * @tparam min_ Minimum value of the integer, known at compile time.
+ * This should be non-negative and no greater than `max_`.
  *
- * `max_` is a compile-time attestations to the properties of the integer.
+ * `max_` and `min_` are compile-time attestations to the properties of the integer.
  * This allows developers to specify more constraints on the integer than would otherwise be provided by `Integer_`.
- * For example, we could attest that a `std::size_t` has a upper limit of `max_ = 2^31 - 1`.
+ * For example, we could attest that a `std::size_t` has a upper limit of `max_ = 2^31 - 1`,
+ * or that a divisor has a lower limit of `min_ = 1`.
  */
-template<typename Integer_, Integer_ max_>
+template<typename Integer_, Integer_ max_, Integer_ min_ = 0>
 struct Attestation {
     static_assert(std::is_integral<Integer_>::value);
     static_assert(max_ >= 0);
+    static_assert(min_ >= 0);
+    static_assert(min_ <= max_);
 
     /**
      * @param x Value of the integer.
-     * This should be no greater than `max_`.
+     * This should lie in `[min_, max_]`.
      */
     constexpr Attestation(Integer_ x) : value(x) {
         assert(x <= max_);
+        assert(x >= min_);
     }
 
     /**
@@ -50,10 +56,25 @@ struct Attestation {
      */
     static constexpr Integer_ max = max_;
 
+    /**
+     * Minimum value of the integer, known at compile time.
+     * This will be non-negative.
+     */
+    static constexpr Integer_ min = min_;
+
     /**
      * Value of the integer.
      */
     Integer_ value;
+
+    /**
+     * @return Value of the integer.
+     * This is `explicit` so that the compile-time bounds are not silently discarded in arithmetic or comparisons;
+     * use `get_value()` (or a `static_cast`) to obtain the raw integer where it is needed.
+     */
+    constexpr explicit operator Integer_() const {
+        return value;
+    }
 };
 
 /**
@@ -74,9 +95,10 @@ struct is_Attestation {
  *
  * @tparam Integer_ See documentation for `Attestation`.
  * @tparam max_ See documentation for `Attestation`.
+ * @tparam min_ See documentation for `Attestation`.
  */
-template<typename Integer_, Integer_ max_>
-struct is_Attestation<Attestation<Integer_, max_> > {
+template<typename Integer_, Integer_ max_, Integer_ min_>
+struct is_Attestation<Attestation<Integer_, max_, min_> > {
     /**
      * True, this class is an `Attestation`.
      */
@@ -125,6 +147,21 @@ constexpr auto get_max() {
     }
 }
 
+/**
+ * @tparam Value_ Integer or `Attestation`.
+ * @return The minimum value of all instances of `Value_`.
+ * For integer types, this is always zero as all values are assumed to be non-negative.
+ */
+template<typename Value_>
+constexpr auto get_min() {
+    if constexpr(std::is_integral<Value_>::value) {
+        return static_cast<Value_>(0);
+    } else {
+        static_assert(is_Attestation<Value_>::value);
+        return Value_::min;
+    }
+}
+
 /**
  * @tparam Max_ Integer type of the new compile-time maximum.
  * @tparam new_max_ The new compile-time maximum.
@@ -150,11 +187,33 @@ constexpr auto attest_max(Value_ x) {
         if constexpr(max_value <= unsigned_new_limit) {
             return x;
         } else {
-            return Attestation<WrappedInteger, static_cast<WrappedInteger>(new_max_)>(x.value);
+            return Attestation<WrappedInteger, static_cast<WrappedInteger>(new_max_), Value_::min>(x.value);
         }
     }
 }
 
+/**
+ * @tparam Min_ Integer type of the new compile-time minimum.
+ * @tparam new_min_ The new compile-time minimum.
+ * This should be non-negative.
+ * @tparam Value_ Integer or `Attestation`.
+ * @param x Integer value or an `Attestation` about an integer.
+ * @return `x` if it is already known to be greater than or equal to `new_min_`, 
+ * otherwise, an `Attestation` that attests to this constraint.
+ * Any existing upper bound on `x` is preserved.
+ */
+template<typename Min_, Min_ new_min_, typename Value_>
+constexpr auto attest_min(Value_ x) {
+    static_assert(new_min_ >= 0);
+    constexpr auto unsigned_new_limit = as_unsigned(new_min_);
+    if constexpr(unsigned_new_limit <= as_unsigned(get_min<Value_>())) {
+        return x;
+    } else {
+        typedef I<decltype(get_value(x))> Integer;
+        return Attestation<Integer, get_max<Value_>(), static_cast<Integer>(new_min_)>(get_value(x));
+    }
+}
+
 /**
  * @tparam Max_ Integer type of the new compile-time maximum.
  * @tparam Value_ Integer or `Attestation`.
@@ -167,6 +226,35 @@ constexpr auto attest_max_by_type(Value_ x) {
     return attest_max<Max_, std::numeric_limits<Max_>::max()>(x);
 }
 
+/**
+ * @cond
+ */
+// Cap a compile-time bound at the maximum of Dest_.
+template<typename Dest_, typename Value_>
+constexpr Dest_ cap_bound(Value_ x) {
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    if (as_unsigned(x) > dest_maxed) {
+        return dest_maxed;
+    } else {
+        return x;
+    }
+}
+
+template<typename Dest_, typename Value_>
+constexpr bool cast_overflows(Value_ x) {
+    static_assert(std::is_integral<Dest_>::value);
+    constexpr auto umaxed = as_unsigned(std::numeric_limits<Dest_>::max());
+    static_assert(is_integral_or_Attestation<Value_>::value);
+    if constexpr(umaxed < as_unsigned(get_max<Value_>())) {
+        return umaxed < as_unsigned(get_value(x));
+    } else {
+        return false;
+    }
+}
+/**
+ * @endcond
+ */
+
 /**
  * @tparam Dest_ Integer type of the destination.
  * @tparam Value_ Integer or `Attestation`.
@@ -176,13 +264,8 @@ constexpr auto attest_max_by_type(Value_ x) {
  */
 template<typename Dest_, typename Value_>
 constexpr bool check_overflow(Value_ x) {
-    static_assert(std::is_integral<Dest_>::value);
-    constexpr auto umaxed = as_unsigned(std::numeric_limits<Dest_>::max());
-    static_assert(is_integral_or_Attestation<Value_>::value);
-    if constexpr(umaxed < as_unsigned(get_max<Value_>())) {
-        if (umaxed < as_unsigned(get_value(x))) {
-            throw std::overflow_error("overflow detected when casting size-like values in sanisizer");
-        }
+    if (cast_overflows<Dest_>(x)) {
+        throw std::overflow_error("overflow detected when casting size-like values in sanisizer");
     }
     return false;
 }
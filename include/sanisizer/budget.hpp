@@ -0,0 +1,250 @@
+#ifndef SANISIZER_BUDGET_HPP
+#define SANISIZER_BUDGET_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <memory>
+#include <new>
+
+#include "arithmetic.hpp"
+
+/**
+ * @file budget.hpp
+ * @brief Thread-safe tracking of a memory budget.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Thread-safe tracking of a memory budget.
+ *
+ * Each allocation is charged against the budget before it is performed, and refunded when it is released.
+ * An allocation is refused if it would cause the total charge to exceed the limit, allowing a job to fail quickly instead of exhausting the memory on a shared node.
+ * The highest total charge is also recorded, which can be used to choose limits or the number of concurrent jobs based on the observed peak usage.
+ *
+ * All updates are performed atomically with overflow checks, so a single `MemoryBudget` can be shared across threads.
+ * This is usually used via a `BudgetAllocator`.
+ */
+class MemoryBudget {
+public:
+    /**
+     * @param limit Maximum number of bytes that can be charged at any given time.
+     */
+    explicit MemoryBudget(std::size_t limit) : my_limit(limit) {}
+
+    /**
+     * @cond
+     */
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+    /**
+     * @endcond
+     */
+
+public:
+    /**
+     * Attempt to charge an allocation against the budget.
+     *
+     * @param bytes Number of bytes to be allocated.
+     * @return Whether the charge was successful, i.e., the total charge would not exceed `limit()`.
+     * If false, the budget is unchanged.
+     */
+    bool try_charge(std::size_t bytes) noexcept {
+        auto current = my_used.load(std::memory_order_relaxed);
+        std::size_t updated;
+        do {
+            const auto candidate = try_sum<std::size_t>(current, bytes);
+            if (!candidate.has_value() || *candidate > my_limit) {
+                return false;
+            }
+            updated = *candidate;
+        } while (!my_used.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+
+        auto peak = my_high_water.load(std::memory_order_relaxed);
+        while (peak < updated && !my_high_water.compare_exchange_weak(peak, updated, std::memory_order_relaxed)) {}
+        return true;
+    }
+
+    /**
+     * Charge an allocation against the budget.
+     *
+     * @param bytes Number of bytes to be allocated.
+     * A `std::bad_alloc` is thrown if the total charge would exceed `limit()`.
+     */
+    void charge(std::size_t bytes) {
+        if (!try_charge(bytes)) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /**
+     * Refund a previously charged allocation.
+     *
+     * @param bytes Number of bytes that were charged.
+     * This should be no greater than `used()`.
+     */
+    void refund(std::size_t bytes) noexcept {
+        [[maybe_unused]] const auto previous = my_used.fetch_sub(bytes, std::memory_order_relaxed);
+        assert(previous >= bytes);
+    }
+
+public:
+    /**
+     * @return Maximum number of bytes that can be charged.
+     */
+    std::size_t limit() const noexcept {
+        return my_limit;
+    }
+
+    /**
+     * @return Number of bytes currently charged.
+     */
+    std::size_t used() const noexcept {
+        return my_used.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Number of bytes that can still be charged.
+     * In multi-threaded code, this may be out of date by the time it is used.
+     */
+    std::size_t available() const noexcept {
+        const auto current = used();
+        return (current < my_limit ? my_limit - current : 0);
+    }
+
+    /**
+     * @return Highest number of bytes that was charged at any given time, since construction or the last call to `reset_high_water()`.
+     */
+    std::size_t high_water() const noexcept {
+        return my_high_water.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Reset the high-water mark to the number of bytes that are currently charged.
+     */
+    void reset_high_water() noexcept {
+        my_high_water.store(used(), std::memory_order_relaxed);
+    }
+
+private:
+    std::size_t my_limit;
+    std::atomic<std::size_t> my_used{ 0 };
+    std::atomic<std::size_t> my_high_water{ 0 };
+};
+
+/**
+ * @brief Allocator that charges a `MemoryBudget`.
+ *
+ * @tparam Type_ Type of the elements.
+ * @tparam Base_ Base allocator class that performs the actual allocation.
+ *
+ * Each allocation is charged against the budget before calling `Base_`, and refunded upon deallocation.
+ * A `std::bad_alloc` is thrown if the charge fails, i.e., the allocation would exceed the budget.
+ *
+ * Containers track the budget through their allocator, so memory is always refunded to the budget that it was charged to.
+ * Allocators are not interchangeable unless they charge the same budget, so they propagate with their memory upon container move assignment and swapping.
+ * Upon copy assignment, the destination container keeps its own allocator and budget.
+ */
+template<typename Type_, class Base_ = std::allocator<Type_> >
+class BudgetAllocator : public Base_ {
+    typedef std::allocator_traits<Base_> Traits;
+
+public:
+    /**
+     * @param budget The budget to charge.
+     * This should outlive the allocator and any containers using it.
+     * @param base Instance of the base allocator.
+     */
+    BudgetAllocator(MemoryBudget& budget, const Base_& base = Base_()) noexcept : Base_(base), my_budget(&budget) {}
+
+    /**
+     * @cond
+     */
+    // Overriding the traits from Base_, which (for std::allocator) assume that all instances are interchangeable.
+    typedef std::false_type is_always_equal;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template<typename Other_>
+    struct rebind {
+        typedef BudgetAllocator<Other_, typename Traits::template rebind_alloc<Other_> > other;
+    };
+
+    template<typename Other_, class OtherBase_>
+    BudgetAllocator(const BudgetAllocator<Other_, OtherBase_>& other) noexcept : Base_(static_cast<const OtherBase_&>(other)), my_budget(other.budget()) {}
+    /**
+     * @endcond
+     */
+
+public:
+    /**
+     * @param n Number of elements to allocate.
+     * @return Pointer to storage for `n` elements.
+     * A `std::bad_array_new_length` is thrown if the number of bytes overflows, and a `std::bad_alloc` is thrown if the budget would be exceeded.
+     */
+    Type_* allocate(std::size_t n) {
+        const auto bytes = try_product<std::size_t>(n, sizeof(Type_));
+        if (!bytes.has_value()) {
+            throw std::bad_array_new_length();
+        }
+
+        my_budget->charge(*bytes);
+        try {
+            return Traits::allocate(static_cast<Base_&>(*this), n);
+        } catch (...) {
+            my_budget->refund(*bytes);
+            throw;
+        }
+    }
+
+    /**
+     * @param ptr Pointer to storage that was previously allocated.
+     * @param n Number of elements that were allocated.
+     */
+    void deallocate(Type_* ptr, std::size_t n) noexcept {
+        Traits::deallocate(static_cast<Base_&>(*this), ptr, n);
+        my_budget->refund(n * sizeof(Type_)); // this can't overflow as it was already checked in allocate().
+    }
+
+    /**
+     * @return Maximum number of elements that can be allocated by the base allocator.
+     * This does not consider the remaining budget, which is only enforced by `allocate()`.
+     * (Containers expect `max_size()` to be constant, e.g., libstdc++'s `std::vector` clamps its new capacity to `max_size()` without checking that it can still hold the existing elements.)
+     */
+    std::size_t max_size() const noexcept {
+        return Traits::max_size(static_cast<const Base_&>(*this));
+    }
+
+    /**
+     * @return Pointer to the budget.
+     */
+    MemoryBudget* budget() const noexcept {
+        return my_budget;
+    }
+
+private:
+    MemoryBudget* my_budget;
+};
+
+/**
+ * @cond
+ */
+template<typename Left_, class LeftBase_, typename Right_, class RightBase_>
+bool operator==(const BudgetAllocator<Left_, LeftBase_>& left, const BudgetAllocator<Right_, RightBase_>& right) noexcept {
+    return left.budget() == right.budget() && static_cast<const LeftBase_&>(left) == static_cast<const RightBase_&>(right);
+}
+
+template<typename Left_, class LeftBase_, typename Right_, class RightBase_>
+bool operator!=(const BudgetAllocator<Left_, LeftBase_>& left, const BudgetAllocator<Right_, RightBase_>& right) noexcept {
+    return !(left == right);
+}
+/**
+ * @endcond
+ */
+
+}
+
+#endif
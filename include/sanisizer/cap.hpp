@@ -42,6 +42,23 @@ constexpr Dest_ cap(Value_ x) {
     }
 }
 
+/**
+ * Variant of `cap()` that preserves compile-time bounds.
+ *
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Value_ Integer type of the input value.
+ * This may also be an `Attestation`.
+ *
+ * @param x Non-negative value to be capped.
+ *
+ * @return An `Attestation` of a `Dest_`, containing `x` if it can be represented in `Dest_`, otherwise the maximum value of `Dest_`.
+ * Its bounds are those of `x`, capped to the maximum of `Dest_`.
+ */
+template<typename Dest_, typename Value_>
+constexpr auto cap_attested(Value_ x) {
+    return Attestation<Dest_, cap_bound<Dest_>(get_max<Value_>()), cap_bound<Dest_>(get_min<Value_>())>(cap<Dest_>(x));
+}
+
 }
 
 #endif
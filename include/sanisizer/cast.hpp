@@ -1,6 +1,8 @@
 #ifndef SANISIZER_CAST_HPP
 #define SANISIZER_CAST_HPP
 
+#include <optional>
+
 #include "attest.hpp"
 
 /**
@@ -47,6 +49,44 @@ constexpr Dest_ cast(Value_ x) {
     return can_cast<Dest_>(x);
 }
 
+/**
+ * Variant of `cast()` that preserves compile-time bounds.
+ * This allows later calls to elide their checks when `x` is an `Attestation` that is known to be small enough.
+ * 
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Value_ Integer type of the input value.
+ * This may also be an `Attestation`.
+ *
+ * @param x Non-negative value to be casted.
+ *
+ * @return `x` as an `Attestation` of a `Dest_`, with the bounds of `x` capped to the maximum of `Dest_`.
+ * An error is thrown if overflow would occur.
+ */
+template<typename Dest_, typename Value_>
+constexpr auto cast_attested(Value_ x) {
+    return Attestation<Dest_, cap_bound<Dest_>(get_max<Value_>()), cap_bound<Dest_>(get_min<Value_>())>(cast<Dest_>(x));
+}
+
+/**
+ * Non-throwing version of `cast()`, for use in `noexcept` code or where overflow is an expected outcome.
+ * The check is skipped at compile time if `x` can always be represented in `Dest_`, in which case this is as cheap as a regular cast.
+ * 
+ * @tparam Dest_ Integer type of the destination.
+ * @tparam Value_ Integer type of the input value.
+ * This may also be an `Attestation`.
+ *
+ * @param x Non-negative value to be casted.
+ *
+ * @return `x` as a `Dest_`, or no value if overflow would occur.
+ */
+template<typename Dest_, typename Value_>
+constexpr std::optional<Dest_> try_cast(Value_ x) noexcept {
+    if (cast_overflows<Dest_>(x)) {
+        return std::nullopt;
+    }
+    return static_cast<Dest_>(get_value(x));
+}
+
 }
 
 #endif
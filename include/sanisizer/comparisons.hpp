@@ -155,6 +155,69 @@ constexpr auto max(First_ first, Second_ second) {
     }
 }
 
+/**
+ * @cond
+ */
+template<typename First_, typename Second_>
+constexpr auto smaller_bound(First_ first, Second_ second) {
+    return (as_unsigned(first) < as_unsigned(second) ? as_unsigned(first) : as_unsigned(second));
+}
+
+template<typename First_, typename Second_>
+constexpr auto larger_bound(First_ first, Second_ second) {
+    return (as_unsigned(first) > as_unsigned(second) ? as_unsigned(first) : as_unsigned(second));
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Variant of `min()` that preserves compile-time bounds.
+ * This allows later calls to elide their checks when the smaller value is known to be small enough, e.g., when it was capped by an `Attestation`.
+ *
+ * @tparam First_ First integer type. 
+ * This may also be an `Attestation`.
+ * @tparam Second_ Second integer type.
+ * This may also be an `Attestation`.
+ *
+ * @param first First non-negative value. 
+ * @param second Second non-negative value. 
+ *
+ * @return The smaller of `first` and `second` as an `Attestation`, using the same integer type as `min()`.
+ * Its maximum is the smaller of the maxima of `First_` and `Second_`, and its minimum is the smaller of their minima.
+ */
+template<typename First_, typename Second_>
+constexpr auto min_attested(First_ first, Second_ second) {
+    const auto output = min(first, second);
+    typedef I<decltype(output)> Output;
+    constexpr Output maxed = smaller_bound(get_max<First_>(), get_max<Second_>());
+    constexpr Output minned = smaller_bound(get_min<First_>(), get_min<Second_>());
+    return Attestation<Output, maxed, minned>(output);
+}
+
+/**
+ * Variant of `max()` that preserves compile-time bounds.
+ *
+ * @tparam First_ First integer type. 
+ * This may also be an `Attestation`.
+ * @tparam Second_ Second integer type.
+ * This may also be an `Attestation`.
+ *
+ * @param first First non-negative value. 
+ * @param second Second non-negative value. 
+ *
+ * @return The larger of `first` and `second` as an `Attestation`, using the same integer type as `max()`.
+ * Its maximum is the larger of the maxima of `First_` and `Second_`, and its minimum is the larger of their minima.
+ */
+template<typename First_, typename Second_>
+constexpr auto max_attested(First_ first, Second_ second) {
+    const auto output = max(first, second);
+    typedef I<decltype(output)> Output;
+    constexpr Output maxed = larger_bound(get_max<First_>(), get_max<Second_>());
+    constexpr Output minned = larger_bound(get_min<First_>(), get_min<Second_>());
+    return Attestation<Output, maxed, minned>(output);
+}
+
 }
 
 #endif
@@ -2,9 +2,16 @@
 #define SANISIZER_CREATE_HPP
 
 #include <utility>
+#include <limits>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
 
 #include "utils.hpp"
 #include "cast.hpp"
+#include "arithmetic.hpp"
 
 /**
  * @file create.hpp
@@ -29,10 +36,124 @@ constexpr auto as_size_type(Value_ x) {
     return cast<I<decltype(std::declval<Container_>().size())> >(x);
 }
 
+/**
+ * @cond
+ */
+template<class Container_, typename = void>
+struct has_value_type : std::false_type {};
+
+template<class Container_>
+struct has_value_type<Container_, std::void_t<typename Container_::value_type> > : std::true_type {};
+
+template<class Container_, typename = void>
+struct has_allocator_type : std::false_type {};
+
+template<class Container_>
+struct has_allocator_type<Container_, std::void_t<typename Container_::allocator_type> > : std::true_type {};
+
+// Standard allocators are guaranteed to have a max_size() that is no less than max_elements_by_bytes(),
+// so we can skip the run-time query of the allocator.
+template<class Allocator_>
+struct is_standard_allocator : std::false_type {};
+
+template<typename Type_>
+struct is_standard_allocator<std::allocator<Type_> > : std::true_type {};
+
+// No object can be larger than the maximum of std::ptrdiff_t, otherwise pointer differences would overflow.
+template<typename Type_>
+constexpr std::size_t max_elements_of_type() {
+    return static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(Type_);
+}
+
+template<class Container_>
+constexpr std::size_t max_elements_by_bytes() {
+    return max_elements_of_type<typename Container_::value_type>();
+}
+
+template<class Container_, typename Value_>
+constexpr bool needs_allocation_check() {
+    if constexpr(has_allocator_type<Container_>::value) {
+        if constexpr(!is_standard_allocator<typename Container_::allocator_type>::value) {
+            return true;
+        }
+    }
+    if constexpr(has_value_type<Container_>::value) {
+        typedef I<decltype(std::declval<Container_>().size())> Size;
+        constexpr auto value_maxed = as_unsigned(get_max<Value_>());
+        constexpr auto size_maxed = as_unsigned(std::numeric_limits<Size>::max());
+        constexpr auto maxed = (value_maxed < size_maxed ? value_maxed : size_maxed);
+        return maxed > max_elements_by_bytes<Container_>();
+    } else {
+        return false;
+    }
+}
+
+template<typename Type_, typename Size_>
+void check_element_byte_size(Size_ n, const char* fun) {
+    if (as_unsigned(n) > max_elements_of_type<Type_>()) {
+        throw std::overflow_error(std::string("number of bytes exceeds the maximum allocation size in sanisizer::") + fun);
+    }
+}
+
+template<class Container_, typename Size_>
+void check_byte_size(Size_ n, const char* fun) {
+    check_element_byte_size<typename Container_::value_type>(n, fun);
+}
+
+template<class Allocator_, typename Size_>
+void check_allocator_size(Size_ n, const Allocator_& alloc, const char* fun) {
+    if (as_unsigned(n) > std::allocator_traits<Allocator_>::max_size(alloc)) {
+        throw std::overflow_error(std::string("number of elements exceeds the allocator's maximum size in sanisizer::") + fun);
+    }
+}
+
+template<class Allocator_, typename First_, typename ... Rest_>
+const Allocator_& find_allocator(const First_& first, const Rest_&... rest) {
+    if constexpr(std::is_same<First_, Allocator_>::value) {
+        return first;
+    } else {
+        return find_allocator<Allocator_>(rest...);
+    }
+}
+
+// The allocator is taken from 'existing' if it is not a null pointer, otherwise from 'args' (e.g., arguments to the constructor).
+// If neither is available, we use a default-constructed allocator if possible.
+template<class Container_, typename Value_, typename ... Args_>
+auto as_allocation_size(Value_ x, const Container_* existing, const char* fun, const Args_&... args) {
+    const auto n = as_size_type<Container_>(x);
+    if constexpr(needs_allocation_check<Container_, Value_>()) {
+        if constexpr(has_value_type<Container_>::value) {
+            check_byte_size<Container_>(n, fun);
+        }
+        if constexpr(has_allocator_type<Container_>::value) {
+            typedef typename Container_::allocator_type Allocator;
+            if constexpr(!is_standard_allocator<Allocator>::value) {
+                if (existing) {
+                    check_allocator_size(n, existing->get_allocator(), fun);
+                } else if constexpr((std::is_same<Args_, Allocator>::value || ...)) {
+                    check_allocator_size(n, find_allocator<Allocator>(args...), fun);
+                } else if constexpr(std::is_default_constructible<Allocator>::value) {
+                    check_allocator_size(n, Allocator(), fun);
+                }
+            }
+        }
+    }
+    return n;
+}
+/**
+ * @endcond
+ */
+
 /**
  * Create a new container of a specified size.
  * This protects against overflow when casting the integer size to the container's size type, see `as_size_type()` for details.
  *
+ * If the container has a `value_type`, this function also checks that the number of bytes does not exceed the maximum size of any object (i.e., the maximum of `std::ptrdiff_t`).
+ * If the container has a non-standard `allocator_type`, the size is also checked against the allocator's `max_size()`,
+ * using the allocator in `args` if one is supplied.
+ * These checks fail quickly with a `std::overflow_error`, rather than passing an impossible request to the allocator.
+ * They are skipped at compile time if the upper bound of `Value_` (or the container's size type) guarantees that the number of bytes will not be excessive.
+ *
  * @tparam Container_ Container class with a `size()` method and a constructor that accepts the size as the first argument.
  * @tparam Value_ Integer type of the input size.
  * @tparam Args_ Further arguments to pass to the container's constructor.
@@ -44,12 +165,14 @@ constexpr auto as_size_type(Value_ x) {
  */
 template<class Container_, typename Value_, typename ... Args_>
 Container_ create(Value_ x, Args_&&... args) {
-    return Container_(as_size_type<Container_>(x), std::forward<Args_>(args)...);
+    const auto n = as_allocation_size<Container_>(x, static_cast<const Container_*>(nullptr), "create", args...);
+    return Container_(n, std::forward<Args_>(args)...);
 }
 
 /**
  * Resize a container to the desired size.
  * This protects against overflow when casting the integer size to the container's size type, see `as_size_type()` for details.
+ * The number of bytes is also checked against the maximum allocation size, see `create()` for details.
  *
  * @tparam Container_ Container class with a `size()` method and a `resize()` method that accepts the size as the first argument.
  * @tparam Value_ Integer type of the input size.
@@ -62,12 +185,14 @@ Container_ create(Value_ x, Args_&&... args) {
  */
 template<class Container_, typename Value_, typename ... Args_>
 void resize(Container_& container, Value_ x, Args_&&... args) {
-    container.resize(as_size_type<Container_>(x), std::forward<Args_>(args)...);
+    const auto n = as_allocation_size<Container_>(x, &container, "resize");
+    container.resize(n, std::forward<Args_>(args)...);
 }
 
 /**
  * Reserve a container to the desired size.
  * This protects against overflow when casting the integer size to the container's size type, see `as_size_type()` for details.
+ * The number of bytes is also checked against the maximum allocation size, see `create()` for details.
  *
  * @tparam Container_ Container class with a `size()` method and a `reserve()` method that accepts the size as the first argument.
  * @tparam Value_ Integer type of the input size.
@@ -80,7 +205,72 @@ void resize(Container_& container, Value_ x, Args_&&... args) {
  */
 template<class Container_, typename Value_, typename ... Args_>
 void reserve(Container_& container, Value_ x, Args_&&... args) {
-    container.reserve(as_size_type<Container_>(x), std::forward<Args_>(args)...);
+    const auto n = as_allocation_size<Container_>(x, &container, "reserve");
+    container.reserve(n, std::forward<Args_>(args)...);
+}
+
+/**
+ * @cond
+ */
+template<class Outer_, typename OuterValue_, typename InnerValue_>
+auto validate_nested_sizes(OuterValue_ outer, InnerValue_ inner) {
+    typedef typename Outer_::value_type Inner;
+    typedef typename Inner::value_type Element;
+    const auto outer_size = as_allocation_size<Outer_>(outer, static_cast<const Outer_*>(nullptr), "create_nested");
+    const auto inner_size = as_allocation_size<Inner>(inner, static_cast<const Inner*>(nullptr), "create_nested");
+    check_element_byte_size<Element>(product<std::size_t>(outer_size, inner_size), "create_nested");
+    return std::make_pair(outer_size, inner_size);
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Create a nested container, e.g., a `std::vector` of `std::vector`s, with the specified number of inner containers (i.e., "rows") that are all of the same size.
+ * This validates the outer size, the inner size and the total number of bytes across all inner containers once,
+ * after which the inner containers are constructed without any further checks.
+ *
+ * @tparam Outer_ Container class with a `size()` method and a constructor that accepts the size and a value for all elements.
+ * This should contain instances of an inner container class that has a `size()` method, a `value_type` and a constructor that accepts the size as the first argument.
+ * @tparam OuterValue_ Integer type of the number of inner containers.
+ * @tparam InnerValue_ Integer type of the size of each inner container.
+ * @tparam Args_ Further arguments to pass to the inner container's constructor.
+ *
+ * @param outer Non-negative value representing the number of inner containers.
+ * @param inner Non-negative value representing the size of each inner container.
+ * @param args Additional arguments to pass to the inner container's constructor after the size.
+ *
+ * @return An instance of the outer container, containing `outer` instances of the inner container, each of size `inner`.
+ * An error is raised if `outer` or `inner` overflow their container's size type, see `as_size_type()`,
+ * or if the total number of bytes of all inner elements exceeds the maximum allocation size, see `create()`.
+ */
+template<class Outer_, typename OuterValue_, typename InnerValue_, typename ... Args_>
+Outer_ create_nested(OuterValue_ outer, InnerValue_ inner, Args_&&... args) {
+    typedef typename Outer_::value_type Inner;
+    const auto sizes = validate_nested_sizes<Outer_>(outer, inner);
+    return Outer_(sizes.first, Inner(sizes.second, std::forward<Args_>(args)...));
+}
+
+/**
+ * Create a single container that holds the contents of a nested container in one contiguous allocation.
+ * Each "row" of length `inner` starts at a multiple of `inner`, and can be accessed with `nd_offset()` or `Shape::offset()` without any further checks.
+ * This checks that the total number of elements fits in the container's size type, and that the number of bytes does not exceed the maximum allocation size, see `create()`.
+ *
+ * @tparam Container_ Container class with a `size()` method, a `value_type` and a constructor that accepts the size as the first argument.
+ * @tparam OuterValue_ Integer type of the number of rows.
+ * @tparam InnerValue_ Integer type of the length of each row.
+ * @tparam Args_ Further arguments to pass to the container's constructor.
+ *
+ * @param outer Non-negative value representing the number of rows.
+ * @param inner Non-negative value representing the length of each row.
+ * @param args Additional arguments to pass to the container's constructor after the size.
+ *
+ * @return An instance of the container of size `outer * inner`.
+ */
+template<class Container_, typename OuterValue_, typename InnerValue_, typename ... Args_>
+Container_ create_flat(OuterValue_ outer, InnerValue_ inner, Args_&&... args) {
+    typedef I<decltype(std::declval<Container_>().size())> Size;
+    return create<Container_>(product<Size>(outer, inner), std::forward<Args_>(args)...);
 }
 
 }
@@ -0,0 +1,260 @@
+#ifndef SANISIZER_EXTENTS_HPP
+#define SANISIZER_EXTENTS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "attest.hpp"
+#include "cast.hpp"
+#include "arithmetic.hpp"
+#include "utils.hpp"
+
+/**
+ * @file extents.hpp
+ * @brief Shape of an N-dimensional array with a mix of static and dynamic extents.
+ */
+
+namespace sanisizer {
+
+/**
+ * Placeholder for an extent that is only known at run time.
+ */
+constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @cond
+ */
+template<std::size_t rank_>
+constexpr std::size_t count_dynamic_extents(const std::array<std::size_t, rank_>& extents) {
+    std::size_t count = 0;
+    for (auto e : extents) {
+        count += (e == dynamic_extent);
+    }
+    return count;
+}
+
+template<typename Size_, std::size_t rank_>
+constexpr bool static_extents_overflow(const std::array<std::size_t, rank_>& extents) {
+    constexpr auto dest_maxed = as_unsigned(std::numeric_limits<Size_>::max());
+    std::uintmax_t prod = 1;
+    for (auto e : extents) {
+        if (e == dynamic_extent) {
+            continue;
+        }
+        if (e > dest_maxed || (e && prod > dest_maxed / e)) {
+            return true;
+        }
+        prod *= e;
+    }
+    return false;
+}
+
+// Strides are only known at compile time if all previous extents are static.
+template<std::size_t rank_>
+constexpr std::array<std::size_t, rank_> static_strides(const std::array<std::size_t, rank_>& extents) {
+    std::array<std::size_t, rank_> output{};
+    std::size_t stride = 1;
+    for (std::size_t d = 0; d < rank_; ++d) {
+        output[d] = stride;
+        if (stride != dynamic_extent) {
+            stride = (extents[d] == dynamic_extent ? dynamic_extent : stride * extents[d]);
+        }
+    }
+    return output;
+}
+
+template<std::size_t rank_>
+constexpr std::array<std::size_t, rank_> dynamic_extent_index(const std::array<std::size_t, rank_>& extents) {
+    std::array<std::size_t, rank_> output{};
+    std::size_t count = 0;
+    for (std::size_t d = 0; d < rank_; ++d) {
+        output[d] = count;
+        count += (extents[d] == dynamic_extent);
+    }
+    return output;
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Shape of an N-dimensional array with a mix of static and dynamic extents.
+ *
+ * @tparam Size_ Integer type to represent the size of the flattened array.
+ * @tparam extents_ Extent of each dimension.
+ * This may be `dynamic_extent` for dimensions with extents that are only known at run time.
+ *
+ * This is a counterpart to `Shape` where some of the extents are known at compile time, e.g., the number of colour channels or the size of a tile.
+ * The product of the static extents is checked with a `static_assert()`, while the dynamic extents are checked for overflow in `Size_` upon construction.
+ * Strides that only depend on static extents are compile-time constants, allowing the compiler to fold them into `offset()`.
+ * As in `nd_offset()`, the first dimension is assumed to be the fastest-changing, followed by the second dimension, and so on.
+ */
+template<typename Size_, std::size_t ... extents_>
+class Extents {
+    static_assert(std::is_integral<Size_>::value);
+
+    static constexpr std::size_t my_rank = sizeof...(extents_);
+    static constexpr std::array<std::size_t, my_rank> my_static_extents{ extents_... };
+    static constexpr std::size_t my_rank_dynamic = count_dynamic_extents(my_static_extents);
+    static constexpr std::array<std::size_t, my_rank> my_static_strides = static_strides(my_static_extents);
+    static constexpr std::array<std::size_t, my_rank> my_dynamic_index = dynamic_extent_index(my_static_extents);
+
+    static_assert(!static_extents_overflow<Size_>(my_static_extents), "product of static extents should fit in the size type");
+
+    std::array<Size_, my_rank_dynamic> my_dynamic_extents;
+    std::array<Size_, my_rank> my_strides;
+    Size_ my_size;
+
+public:
+    /**
+     * @tparam Dynamic_ Integer types of the dynamic extents.
+     * Any of these may also be `Attestation`s.
+     * @param dynamic Non-negative extent of each dynamic dimension, in order of increasing dimension index.
+     * This should have length equal to `rank_dynamic()`.
+     *
+     * An error is raised if any dynamic extent, stride or the product of all extents overflows `Size_`, see `cast()` and `product()` for details.
+     * Only dimensions with non-constant strides (i.e., after the first dynamic extent) require any checks.
+     */
+    template<typename ... Dynamic_>
+    constexpr Extents(Dynamic_... dynamic) : my_dynamic_extents{ cast<Size_>(dynamic)... }, my_strides{}, my_size(1) {
+        static_assert(sizeof...(Dynamic_) == my_rank_dynamic);
+        for (std::size_t d = 0; d < my_rank; ++d) {
+            my_strides[d] = my_size;
+            if (my_static_strides[d] != dynamic_extent && my_static_extents[d] != dynamic_extent) {
+                // Bounded by the product of static extents, so no check is required.
+                my_size = static_cast<Size_>(my_static_strides[d] * my_static_extents[d]);
+            } else {
+                my_size = product<Size_>(my_size, extent(d));
+            }
+        }
+    }
+
+public:
+    /**
+     * @return Number of dimensions.
+     */
+    static constexpr std::size_t rank() {
+        return my_rank;
+    }
+
+    /**
+     * @return Number of dimensions with dynamic extents.
+     */
+    static constexpr std::size_t rank_dynamic() {
+        return my_rank_dynamic;
+    }
+
+    /**
+     * @param d Index of the dimension.
+     * @return Static extent of dimension `d`, or `dynamic_extent` if its extent is only known at run time.
+     */
+    static constexpr std::size_t static_extent(std::size_t d) {
+        return my_static_extents[d];
+    }
+
+    /**
+     * @param d Index of the dimension.
+     * @return Extent of dimension `d`.
+     */
+    constexpr Size_ extent(std::size_t d) const {
+        if (my_static_extents[d] == dynamic_extent) {
+            return my_dynamic_extents[my_dynamic_index[d]];
+        } else {
+            return static_cast<Size_>(my_static_extents[d]);
+        }
+    }
+
+    /**
+     * @tparam d_ Index of the dimension.
+     * @return Extent of dimension `d_`.
+     * For static extents, this is returned as an `Attestation` so that the bounds can be used to elide checks in `product()`, etc.
+     */
+    template<std::size_t d_>
+    constexpr auto extent() const {
+        static_assert(d_ < my_rank);
+        if constexpr(my_static_extents[d_] == dynamic_extent) {
+            return my_dynamic_extents[my_dynamic_index[d_]];
+        } else {
+            constexpr Size_ val = my_static_extents[d_];
+            return Attestation<Size_, val, val>(val);
+        }
+    }
+
+    /**
+     * @return Extents of all dimensions.
+     */
+    constexpr std::array<Size_, my_rank> extents() const {
+        std::array<Size_, my_rank> output{};
+        for (std::size_t d = 0; d < my_rank; ++d) {
+            output[d] = extent(d);
+        }
+        return output;
+    }
+
+    /**
+     * @param d Index of the dimension.
+     * @return Stride of dimension `d`, i.e., the product of the extents of all previous dimensions.
+     */
+    constexpr Size_ stride(std::size_t d) const {
+        return my_strides[d];
+    }
+
+    /**
+     * @tparam d_ Index of the dimension.
+     * @return Stride of dimension `d_`.
+     * This is a compile-time constant if all previous dimensions have static extents.
+     */
+    template<std::size_t d_>
+    constexpr Size_ stride() const {
+        static_assert(d_ < my_rank);
+        if constexpr(my_static_strides[d_] != dynamic_extent) {
+            return static_cast<Size_>(my_static_strides[d_]);
+        } else {
+            return my_strides[d_];
+        }
+    }
+
+    /**
+     * @return Total number of elements in the array, i.e., the product of the extents.
+     */
+    constexpr Size_ size() const {
+        return my_size;
+    }
+
+private:
+    template<std::size_t ... d_, typename ... Indices_>
+    constexpr Size_ offset_internal(std::index_sequence<d_...>, Indices_... indices) const {
+#ifndef NDEBUG
+        (assert(static_cast<Size_>(get_value(indices)) < extent(d_)), ...);
+#endif
+        return (static_cast<Size_>(0) + ... + static_cast<Size_>(static_cast<Size_>(get_value(indices)) * stride<d_>()));
+    }
+
+public:
+    /**
+     * Compute the offset for an element of the flattened array.
+     * No overflow checks are performed as the offset is guaranteed to be less than `size()` for valid indices.
+     * Multiplications by constant strides are folded by the compiler.
+     *
+     * @tparam Indices_ Integer types of the indices.
+     * It is assumed that these can be safely cast to `Size_`.
+     * @param indices Position of the element on each dimension.
+     * This should have length equal to `rank()`, and each index should be less than the extent of its dimension.
+     *
+     * @return Offset into the array for the element at `indices`.
+     */
+    template<typename ... Indices_>
+    constexpr Size_ offset(Indices_... indices) const {
+        static_assert(sizeof...(Indices_) == my_rank);
+        return offset_internal(std::make_index_sequence<my_rank>(), indices...);
+    }
+};
+
+}
+
+#endif
@@ -6,6 +6,10 @@
 #include <stdexcept>
 #include <type_traits>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 
 #include "utils.hpp"
 #include "attest.hpp"
@@ -55,64 +59,221 @@ int required_bits_for_float(Float_ x) {
 }
 
 /**
- * Safely convert a non-negative floating-point number to an integer with truncation.
- * This is occasionally necessary when the size of a container or number of loop iterations is determined by floating-point calculations.
- *
- * @tparam Integer_ Integer type.
- * @tparam Float_ Floating-point type.
- *
- * @param x Floating-point number, usually holding some kind of size. 
- *
- * @return The value of `x` as an integer, after truncation.
- * An exception is raised if `x` is negative, non-finite or overflow would occur.
+ * @cond
  */
+enum class FromFloatStatus : char { ok, non_finite, negative, overflow };
+
+// Shared by from_float() and try_from_float(), so that both apply the same checks.
+// On success, 'x' is truncated in place so that it can be directly cast to Integer_.
 template<typename Integer_, typename Float_>
-Integer_ from_float(Float_ x) {
+FromFloatStatus from_float_status(Float_& x) noexcept {
     static_assert(std::is_floating_point<Float_>::value);
     static_assert(std::is_integral<Integer_>::value);
 
     if (!std::isfinite(x)) {
-        throw std::range_error("invalid conversion of non-finite value in sanisizer::from_float");
+        return FromFloatStatus::non_finite;
     }
     if (x < 0) {
-        throw std::out_of_range("negative input value in sanisizer::from_float");
+        return FromFloatStatus::negative;
     }
     x = std::trunc(x);
 
     constexpr auto output_precision = std::numeric_limits<Integer_>::digits;
     if (required_bits_for_float(x) > output_precision) {
-        throw std::overflow_error("overflow detected in sanisizer::from_float");
+        return FromFloatStatus::overflow;
     }
 
+    return FromFloatStatus::ok;
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Safely convert a non-negative floating-point number to an integer with truncation.
+ * This is occasionally necessary when the size of a container or number of loop iterations is determined by floating-point calculations.
+ *
+ * @tparam Integer_ Integer type.
+ * @tparam Float_ Floating-point type.
+ *
+ * @param x Floating-point number, usually holding some kind of size. 
+ *
+ * @return The value of `x` as an integer, after truncation.
+ * An exception is raised if `x` is negative, non-finite or overflow would occur.
+ */
+template<typename Integer_, typename Float_>
+Integer_ from_float(Float_ x) {
+    switch (from_float_status<Integer_>(x)) {
+        case FromFloatStatus::non_finite:
+            throw std::range_error("invalid conversion of non-finite value in sanisizer::from_float");
+        case FromFloatStatus::negative:
+            throw std::out_of_range("negative input value in sanisizer::from_float");
+        case FromFloatStatus::overflow:
+            throw std::overflow_error("overflow detected in sanisizer::from_float");
+        default:
+            break;
+    }
     return x;
 }
 
 /**
- * Safely convert a non-negative integer into a floating-point number without loss of precision.
- * This is occasionally necessary when the surrounding environment does not have a dedicated integer type (e.g., Javascript).
+ * Non-throwing version of `from_float()`, for use in `noexcept` code or where invalid inputs are an expected outcome.
  *
- * Note that the "safety" of this function is based on preserving precision rather than avoiding undefined behavior.
- * If the implementation's floats are compliant with the IEEE-754 specifiation, very large integers will already be safely converted to positive infinity via regular casts.
+ * @tparam Integer_ Integer type.
+ * @tparam Float_ Floating-point type.
+ *
+ * @param x Floating-point number, usually holding some kind of size. 
+ *
+ * @return The value of `x` as an integer, after truncation.
+ * No value is returned if `x` is negative, non-finite or overflow would occur.
+ */
+template<typename Integer_, typename Float_>
+std::optional<Integer_> try_from_float(Float_ x) noexcept {
+    if (from_float_status<Integer_>(x) != FromFloatStatus::ok) {
+        return std::nullopt;
+    }
+    return static_cast<Integer_>(x);
+}
+
+/**
+ * @cond
+ */
+// Smallest power of 2 that cannot be stored in Integer_, as a Float_.
+// Any finite non-negative float below this limit can be safely truncated to an Integer_.
+template<typename Integer_, typename Float_>
+constexpr Float_ from_float_upper_limit() {
+    constexpr auto idig = std::numeric_limits<Integer_>::digits;
+    if constexpr(idig >= std::numeric_limits<Float_>::max_exponent) {
+        return std::numeric_limits<Float_>::infinity();
+    } else {
+        Float_ output = 1;
+        for (I<decltype(idig)> d = 0; d < idig; ++d) {
+            output *= 2;
+        }
+        return output;
+    }
+}
+
+// Unsigned integer type with the same size as an IEEE float, or void if no such type is available.
+template<typename Float_>
+struct float_bits {
+    typedef typename std::conditional<
+        std::numeric_limits<Float_>::is_iec559 && sizeof(Float_) == sizeof(std::uint32_t),
+        std::uint32_t,
+        typename std::conditional<
+            std::numeric_limits<Float_>::is_iec559 && sizeof(Float_) == sizeof(std::uint64_t),
+            std::uint64_t,
+            void
+        >::type
+    >::type type;
+};
+/**
+ * @endcond
+ */
+
+/**
+ * Convert an array of non-negative floating-point numbers to integers with truncation.
+ * This is equivalent to calling `from_float()` on each element but is more efficient for large arrays.
+ * Specifically, elements are validated in blocks against a precomputed limit without any calls to `std::isfinite()`, `std::trunc()` or `std::ilogb()`.
+ * For IEEE floats, the validation is performed with integer operations on the bit patterns so that the compiler can vectorize the loop.
  *
  * @tparam Integer_ Integer type.
- * This can also be an `Attestation`.
  * @tparam Float_ Floating-point type.
  *
- * @param x Non-negative integer, usually holding some kind of size. 
+ * @param n Number of elements.
+ * @param input Pointer to an array of length `n`, containing floating-point numbers.
+ * @param[out] output Pointer to an array of length `n`, in which to store the truncated integers.
  *
- * @return The value of `x` as a floating-point number.
- * An exception is raised if overflow would occur.
+ * @return Index of the first element of `input` that is negative, non-finite or would overflow `Integer_`.
+ * If all elements are valid, `n` is returned instead.
+ * If an invalid element is present, all elements of `output` before the returned index are filled, while the contents of all other elements are unchanged.
+ * Users can call `from_float()` on the offending element to obtain a suitable exception.
+ */
+template<typename Integer_, typename Float_>
+std::size_t from_float_bulk(std::size_t n, const Float_* input, Integer_* output) {
+    static_assert(std::is_floating_point<Float_>::value);
+    static_assert(std::is_integral<Integer_>::value);
+
+#ifndef SANISIZER_FLOAT_FORCE_FREXP
+    if constexpr(std::numeric_limits<Float_>::radix == 2) {
+        // NaNs and infinities fail at least one of the comparisons, so there's no need for a separate std::isfinite() check.
+        constexpr Float_ upper = from_float_upper_limit<Integer_, Float_>();
+        std::size_t i = 0;
+
+        typedef typename float_bits<Float_>::type Bits;
+        if constexpr(!std::is_void<Bits>::value) {
+            // For IEEE floats, the bit patterns of non-negative values (including infinity and NaN) are ordered in the same manner as the values themselves.
+            // So, a value is valid if and only if its sign bit is not set and its bits are less than those of 'upper'.
+            // This can be checked with integer operations that are vectorized more readily than floating-point comparisons.
+            // Specifically, the top bit of 'bits | (upper_bits - 1 - bits)' is set if the sign bit is set or if 'bits >= upper_bits'.
+            Bits upper_bits;
+            std::memcpy(&upper_bits, &upper, sizeof(Float_));
+            constexpr int top_shift = std::numeric_limits<Bits>::digits - 1;
+            constexpr std::size_t block_size = 64;
+
+            while (n - i >= block_size) {
+                Bits invalid = 0;
+                for (std::size_t j = 0; j < block_size; ++j) {
+                    Bits bits;
+                    std::memcpy(&bits, input + i + j, sizeof(Float_));
+                    invalid |= bits | (upper_bits - 1 - bits);
+                }
+
+                if ((invalid >> top_shift) == 0) {
+                    for (std::size_t j = 0; j < block_size; ++j) {
+                        output[i + j] = static_cast<Integer_>(input[i + j]);
+                    }
+                } else {
+                    // Negative zeros also end up here, so we need to check each element in the block properly.
+                    for (std::size_t j = 0; j < block_size; ++j) {
+                        const Float_ x = input[i + j];
+                        if (!(x >= 0 && x < upper)) {
+                            return i + j;
+                        }
+                        output[i + j] = static_cast<Integer_>(x);
+                    }
+                }
+                i += block_size;
+            }
+        }
+
+        for (; i < n; ++i) {
+            const Float_ x = input[i];
+            if (!(x >= 0 && x < upper)) {
+                return i;
+            }
+            output[i] = static_cast<Integer_>(x);
+        }
+        return n;
+
+    } else {
+#endif
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto converted = try_from_float<Integer_>(input[i]);
+            if (!converted.has_value()) {
+                return i;
+            }
+            output[i] = *converted;
+        }
+        return n;
+#ifndef SANISIZER_FLOAT_FORCE_FREXP
+    }
+#endif
+}
+
+/**
+ * @cond
  */
 template<typename Float_, typename Integer_>
-Float_ to_float(Integer_ x) {
+bool to_float_overflows(Integer_ x) {
     const auto val = get_value(x);
 
     // protect against the various -1 operations.
     constexpr auto xmax = get_max<I<decltype(x)> >();
     if constexpr(xmax == 0) {
-        return 0;
+        return false;
     } else if (val == 0) {
-        return 0;
+        return false;
     }
 
     constexpr auto frad = std::numeric_limits<Float_>::radix;
@@ -123,7 +284,7 @@ Float_ to_float(Integer_ x) {
             if constexpr((xmax - 1) >> fdig) {
                 const auto y = (val - 1) >> fdig;
                 if (y) {
-                    throw std::overflow_error("overflow detected in sanisizer::to_float");
+                    return true;
                 }
             }
         }
@@ -135,13 +296,59 @@ Float_ to_float(Integer_ x) {
             working /= frad;
         }
         if (working) {
-            throw std::overflow_error("overflow detected in sanisizer::to_float");
+            return true;
         }
 #ifndef SANISIZER_FLOAT_FORCE_MANUAL
     }
 #endif
 
-    return val;
+    return false;
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Safely convert a non-negative integer into a floating-point number without loss of precision.
+ * This is occasionally necessary when the surrounding environment does not have a dedicated integer type (e.g., Javascript).
+ *
+ * Note that the "safety" of this function is based on preserving precision rather than avoiding undefined behavior.
+ * If the implementation's floats are compliant with the IEEE-754 specifiation, very large integers will already be safely converted to positive infinity via regular casts.
+ *
+ * @tparam Integer_ Integer type.
+ * This can also be an `Attestation`.
+ * @tparam Float_ Floating-point type.
+ *
+ * @param x Non-negative integer, usually holding some kind of size. 
+ *
+ * @return The value of `x` as a floating-point number.
+ * An exception is raised if overflow would occur.
+ */
+template<typename Float_, typename Integer_>
+Float_ to_float(Integer_ x) {
+    if (to_float_overflows<Float_>(x)) {
+        throw std::overflow_error("overflow detected in sanisizer::to_float");
+    }
+    return get_value(x);
+}
+
+/**
+ * Non-throwing version of `to_float()`, for use in `noexcept` code or where overflow is an expected outcome.
+ *
+ * @tparam Integer_ Integer type.
+ * This can also be an `Attestation`.
+ * @tparam Float_ Floating-point type.
+ *
+ * @param x Non-negative integer, usually holding some kind of size. 
+ *
+ * @return The value of `x` as a floating-point number, or no value if overflow would occur.
+ */
+template<typename Float_, typename Integer_>
+std::optional<Float_> try_to_float(Integer_ x) noexcept {
+    if (to_float_overflows<Float_>(x)) {
+        return std::nullopt;
+    }
+    return static_cast<Float_>(get_value(x));
 }
 
 }
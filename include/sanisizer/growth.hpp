@@ -0,0 +1,179 @@
+#ifndef SANISIZER_GROWTH_HPP
+#define SANISIZER_GROWTH_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "utils.hpp"
+#include "attest.hpp"
+#include "cast.hpp"
+#include "arithmetic.hpp"
+#include "comparisons.hpp"
+#include "create.hpp"
+
+/**
+ * @file growth.hpp
+ * @brief Overflow-safe geometric growth of container capacities.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Options for `next_capacity()` and `reserve_for_append()`.
+ */
+struct GrowthOptions {
+    /**
+     * Numerator of the growth factor, i.e., the capacity is multiplied by `factor_numerator / factor_denominator` when it needs to grow.
+     */
+    std::size_t factor_numerator = 2;
+
+    /**
+     * Denominator of the growth factor.
+     * This should be positive and no greater than `factor_numerator`.
+     */
+    std::size_t factor_denominator = 1;
+
+    /**
+     * Minimum increase in the capacity, in terms of the number of elements.
+     */
+    std::size_t minimum_increment = 0;
+
+    /**
+     * Page size in bytes.
+     * If positive, the capacity is increased so that the total number of bytes is a multiple of the page size (where possible).
+     */
+    std::size_t page_size = 0;
+
+    /**
+     * Maximum number of bytes for the new capacity.
+     * Growth beyond the required size is capped so that the total number of bytes does not exceed this limit.
+     * The returned capacity is never less than the required size, even if this limit is exceeded.
+     *
+     * This is intended for allocators with a limited supply of memory, e.g., `BudgetAllocator` or `ArenaAllocator`.
+     * Their `max_size()` is constant and does not reflect the remaining memory, so this should be set to, e.g., `MemoryBudget::available()` or `Arena::available()`.
+     * It is ignored for containers without a `value_type`.
+     */
+    std::size_t maximum_bytes = std::numeric_limits<std::size_t>::max();
+};
+
+/**
+ * @cond
+ */
+// Largest capacity that the container could possibly have, considering the size type, the byte count and the allocator.
+template<class Container_>
+auto max_capacity(const Container_& container) {
+    typedef I<decltype(container.size())> Size;
+    auto limit = as_unsigned(std::numeric_limits<Size>::max());
+    if constexpr(has_value_type<Container_>::value) {
+        limit = min(limit, max_elements_by_bytes<Container_>());
+    }
+    if constexpr(has_allocator_type<Container_>::value) {
+        limit = min(limit, std::allocator_traits<typename Container_::allocator_type>::max_size(container.get_allocator()));
+    }
+    return static_cast<Size>(limit);
+}
+
+template<typename Size_>
+Size_ saturating_sum(Size_ x, std::size_t y, Size_ limit) {
+    const auto output = try_sum<Size_>(x, y);
+    return (output.has_value() && *output < limit ? *output : limit);
+}
+/**
+ * @endcond
+ */
+
+/**
+ * Compute the next capacity of a container that needs to hold at least `required` elements.
+ * The current capacity is grown geometrically to amortize the cost of repeated reallocations, subject to the constraints in `options`.
+ * All calculations saturate at the maximum capacity of the container (i.e., `cap()` semantics),
+ * as determined from the container's size type, the maximum allocation size and the allocator's `max_size()`.
+ * The allocator's `max_size()` is treated as a constant limit, so any limits on the remaining memory should be supplied via `GrowthOptions::maximum_bytes`.
+ *
+ * @tparam Container_ Container class with `size()` and `capacity()` methods.
+ * @tparam Value_ Integer type of the required size.
+ * This may also be an `Attestation`.
+ *
+ * @param container An existing instance of the container.
+ * @param required Non-negative value representing the number of elements that the container must be able to hold.
+ * @param options Further options.
+ *
+ * @return The new capacity, which is no less than `required` and no greater than the maximum capacity of the container.
+ * If `required` is already less than or equal to the current capacity, the current capacity is returned.
+ * An `std::overflow_error` is thrown if `required` exceeds the maximum capacity.
+ */
+template<class Container_, typename Value_>
+auto next_capacity(const Container_& container, Value_ required, const GrowthOptions& options = GrowthOptions()) {
+    typedef I<decltype(container.size())> Size;
+    const Size limit = max_capacity(container);
+    const Size minimum = as_size_type<Container_>(required);
+    if (as_unsigned(minimum) > as_unsigned(limit)) {
+        throw std::overflow_error("required size exceeds the maximum capacity in sanisizer::next_capacity");
+    }
+
+    const Size current = container.capacity();
+    if (minimum <= current) {
+        return current;
+    }
+
+    Size target = limit;
+    const auto scaled = try_product<Size>(current, options.factor_numerator);
+    if (scaled.has_value() && options.factor_denominator) {
+        target = min(*scaled / options.factor_denominator, limit);
+    }
+    target = max(target, saturating_sum(current, options.minimum_increment, limit));
+    target = max(target, minimum);
+
+    if constexpr(has_value_type<Container_>::value) {
+        if (options.page_size) {
+            constexpr std::size_t element_size = sizeof(typename Container_::value_type);
+            const auto bytes = try_product<std::size_t>(target, element_size);
+            if (bytes.has_value()) {
+                const auto remainder = *bytes % options.page_size;
+                if (remainder) {
+                    const auto padded = try_sum<std::size_t>(*bytes, options.page_size - remainder);
+                    if (padded.has_value()) {
+                        target = min(*padded / element_size, limit);
+                    } else {
+                        target = limit;
+                    }
+                }
+            }
+        }
+
+        const auto soft_limit = options.maximum_bytes / sizeof(typename Container_::value_type);
+        if (as_unsigned(target) > soft_limit) {
+            target = max(static_cast<Size>(soft_limit), minimum); // soft_limit < target <= limit, so the cast is safe.
+        }
+    }
+
+    return target;
+}
+
+/**
+ * Reserve enough space to append `extra` elements to a container.
+ * This validates that `container.size() + extra` does not overflow, and then grows the capacity as described in `next_capacity()`.
+ * If the current capacity is already sufficient, this function does nothing.
+ *
+ * @tparam Container_ Container class with `size()`, `capacity()` and `reserve()` methods.
+ * @tparam Value_ Integer type of the number of extra elements.
+ * This may also be an `Attestation`.
+ *
+ * @param container An existing instance of the container.
+ * @param extra Non-negative number of elements to be appended.
+ * @param options Further options.
+ */
+template<class Container_, typename Value_>
+void reserve_for_append(Container_& container, Value_ extra, const GrowthOptions& options = GrowthOptions()) {
+    typedef I<decltype(container.size())> Size;
+    const Size required = sum<Size>(container.size(), extra);
+    if (required <= container.capacity()) {
+        return;
+    }
+    container.reserve(next_capacity(container, required, options));
+}
+
+}
+
+#endif
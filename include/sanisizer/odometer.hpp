@@ -0,0 +1,285 @@
+#ifndef SANISIZER_ODOMETER_HPP
+#define SANISIZER_ODOMETER_HPP
+
+#include <array>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "attest.hpp"
+#include "cast.hpp"
+#include "arithmetic.hpp"
+#include "shape.hpp"
+
+/**
+ * @file odometer.hpp
+ * @brief Incremental iteration over an N-dimensional array.
+ */
+
+namespace sanisizer {
+
+/**
+ * Placeholder for the number of dimensions when this is only known at run time.
+ */
+constexpr std::size_t dynamic_rank = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Incremental iteration over an N-dimensional array.
+ *
+ * @tparam Size_ Integer type to represent the size of the flattened array.
+ * @tparam ndim_ Number of dimensions.
+ * This may be `dynamic_rank` if the number of dimensions is only known at run time.
+ *
+ * An `Odometer` iterates over all elements of a (hyper)rectangular region of an N-dimensional array, in the same order as they are stored in memory.
+ * As in `nd_offset()`, the first dimension is assumed to be the fastest-changing, followed by the second dimension, and so on.
+ * It keeps track of the current position and offset, updating them with additions when advancing to the next element.
+ * This avoids recomputing the offset from the position for every element, allowing nested loops to be replaced by a single loop:
+ *
+ * ```cpp
+ * for (sanisizer::Odometer<std::size_t, 3> odo(shape); odo.valid(); odo.next()) {
+ *     buffer[odo.offset()] = 0;
+ * }
+ * ```
+ *
+ * The extents of the array and the region are validated upon construction so that no further checks are required during iteration.
+ */
+template<typename Size_, std::size_t ndim_ = dynamic_rank>
+class Odometer {
+    static_assert(std::is_integral<Size_>::value);
+
+public:
+    /**
+     * Container of per-dimension values.
+     * This is a `std::vector` if `ndim_ = dynamic_rank`, otherwise it is a `std::array`.
+     */
+    typedef std::conditional_t<ndim_ == dynamic_rank, std::vector<Size_>, std::array<Size_, ndim_> > Vector;
+
+private:
+    Vector my_strides, my_start, my_count, my_position;
+    Size_ my_offset = 0;
+    Size_ my_size = 1;
+    bool my_valid = true;
+
+    template<class Input_>
+    static Vector copy_values(const Input_& input) {
+        Vector output{};
+        if constexpr(ndim_ == dynamic_rank) {
+            output.resize(input.size());
+        } else if (input.size() != ndim_) {
+            throw std::invalid_argument("number of values should be equal to the number of dimensions in sanisizer::Odometer");
+        }
+
+        std::size_t d = 0;
+        for (const auto& in : input) {
+            output[d] = cast<Size_>(in);
+            ++d;
+        }
+        return output;
+    }
+
+    void initialize(const Vector& extents, Vector start, Vector count) {
+        const std::size_t ndim = extents.size();
+        if (start.size() != ndim || count.size() != ndim) {
+            throw std::invalid_argument("number of values should be equal to the number of dimensions in sanisizer::Odometer");
+        }
+
+        my_strides = extents;
+        Size_ stride = 1;
+        for (std::size_t d = 0; d < ndim; ++d) {
+            if (start[d] > extents[d] || count[d] > extents[d] - start[d]) {
+                throw std::out_of_range("region should lie within the array in sanisizer::Odometer");
+            }
+            my_strides[d] = stride;
+            stride = product<Size_>(stride, extents[d]);
+        }
+
+        start_region(std::move(start), std::move(count));
+    }
+
+    void start_region(Vector start, Vector count) {
+        // This cannot overflow as the region lies within the array and the product of the extents was already checked.
+        my_size = 1;
+        for (auto c : count) {
+            my_size *= c;
+        }
+
+        my_offset = 0;
+        my_valid = (my_size > 0);
+        if (my_valid) { // all starts must be less than their extents, so the offset is a valid element.
+            for (std::size_t d = 0, ndim = start.size(); d < ndim; ++d) {
+                my_offset += start[d] * my_strides[d];
+            }
+        }
+        my_position = start;
+        my_start = std::move(start);
+        my_count = std::move(count);
+    }
+
+public:
+    /**
+     * Iterate over all elements of an array.
+     *
+     * @tparam Extents_ Container of integers or `Attestation`s, e.g., a `std::vector` or `std::array`.
+     * @param extents Non-negative extent of each dimension.
+     * If `ndim_` is not `dynamic_rank`, the length of this container should be equal to `ndim_`.
+     *
+     * An error is raised if any extent or the product of extents overflows `Size_`, see `Shape` for details.
+     */
+    template<class Extents_, typename = std::enable_if_t<!std::is_same<Extents_, Odometer>::value> >
+    Odometer(const Extents_& extents) {
+        auto ext = copy_values(extents);
+        auto zero = ext;
+        std::fill(zero.begin(), zero.end(), 0);
+        initialize(ext, std::move(zero), ext);
+    }
+
+    /**
+     * Iterate over a (hyper)rectangular region of an array.
+     *
+     * @tparam Extents_ Container of integers or `Attestation`s, e.g., a `std::vector` or `std::array`.
+     * @tparam Start_ Container of integers or `Attestation`s.
+     * @tparam Count_ Container of integers or `Attestation`s.
+     *
+     * @param extents Non-negative extent of each dimension of the array.
+     * If `ndim_` is not `dynamic_rank`, the length of this container should be equal to `ndim_`.
+     * @param start Non-negative start of the region on each dimension.
+     * This should have the same length as `extents`.
+     * @param count Non-negative length of the region on each dimension.
+     * This should have the same length as `extents`.
+     *
+     * An error is raised if any extent or the product of extents overflows `Size_`, or if the region does not lie within the array.
+     */
+    template<class Extents_, class Start_, class Count_>
+    Odometer(const Extents_& extents, const Start_& start, const Count_& count) {
+        initialize(copy_values(extents), copy_values(start), copy_values(count));
+    }
+
+    /**
+     * Iterate over all elements of an array with a pre-validated shape.
+     *
+     * @param shape Shape of the array.
+     */
+    template<std::size_t shape_ndim_, typename = std::enable_if_t<shape_ndim_ == ndim_> >
+    Odometer(const Shape<Size_, shape_ndim_>& shape) : my_strides(shape.strides()) {
+        start_region(Vector{}, shape.extents());
+    }
+
+    /**
+     * Iterate over a (hyper)rectangular region of an array with a pre-validated shape.
+     *
+     * @tparam Start_ Container of integers or `Attestation`s.
+     * @tparam Count_ Container of integers or `Attestation`s.
+     *
+     * @param shape Shape of the array.
+     * @param start Non-negative start of the region on each dimension.
+     * @param count Non-negative length of the region on each dimension.
+     *
+     * An error is raised if the region does not lie within the array.
+     */
+    template<std::size_t shape_ndim_, class Start_, class Count_, typename = std::enable_if_t<shape_ndim_ == ndim_> >
+    Odometer(const Shape<Size_, shape_ndim_>& shape, const Start_& start, const Count_& count) {
+        initialize(shape.extents(), copy_values(start), copy_values(count));
+    }
+
+public:
+    /**
+     * @return Whether the odometer currently refers to an element of the region.
+     * This is false once `next()` has been called on the last element, or if the region is empty.
+     */
+    bool valid() const {
+        return my_valid;
+    }
+
+    /**
+     * @return Offset of the current element in the flattened array.
+     * This should only be called if `valid()` is true.
+     */
+    Size_ offset() const {
+        return my_offset;
+    }
+
+    /**
+     * @return Position of the current element on each dimension.
+     * This should only be used if `valid()` is true.
+     */
+    const Vector& position() const {
+        return my_position;
+    }
+
+    /**
+     * @return Number of elements in the region.
+     */
+    Size_ size() const {
+        return my_size;
+    }
+
+    /**
+     * Advance to the next element of the region.
+     * This should only be called if `valid()` is true.
+     */
+    void next() {
+        // Fast path for the first dimension, which always has unit stride.
+        const std::size_t ndim = my_position.size();
+        if (ndim && my_position[0] - my_start[0] + 1 < my_count[0]) {
+            ++my_position[0];
+            ++my_offset;
+            return;
+        }
+
+        for (std::size_t d = 0; d < ndim; ++d) {
+            if (my_position[d] - my_start[d] + 1 < my_count[d]) {
+                ++my_position[d];
+                my_offset += my_strides[d];
+                return;
+            }
+
+            // Rolling over to the start of this dimension before carrying over to the next.
+            // We do this before any increment so that the offset never exceeds that of the last element of the region.
+            my_position[d] = my_start[d];
+            my_offset -= (my_count[d] - 1) * my_strides[d];
+        }
+        my_valid = false;
+    }
+
+    /**
+     * Visit all remaining elements of the region.
+     * This is equivalent to calling `next()` in a loop but is more efficient as the first dimension is handled by a tight inner loop.
+     * After this function returns, `valid()` will be false.
+     *
+     * @tparam Function_ Function that accepts a `Size_` and returns nothing.
+     * @param fun Function to be called with the offset of each remaining element.
+     */
+    template<class Function_>
+    void visit(Function_ fun) {
+        if (!my_valid) {
+            return;
+        }
+        if (my_position.size() == 0) {
+            fun(my_offset);
+            my_valid = false;
+            return;
+        }
+
+        // The first dimension always has unit stride, so the inner loop is just a contiguous run of offsets.
+        do {
+            const Size_ remaining = my_count[0] - (my_position[0] - my_start[0]);
+            const Size_ base = my_offset;
+            for (Size_ i = 0; i < remaining; ++i) {
+                fun(static_cast<Size_>(base + i));
+            }
+
+            // Moving to the last element of the first dimension and then using next() to handle the carry.
+            my_offset += remaining - 1;
+            my_position[0] = my_start[0] + my_count[0] - 1;
+            next();
+        } while (my_valid);
+    }
+};
+
+}
+
+#endif
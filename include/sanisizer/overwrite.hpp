@@ -0,0 +1,139 @@
+#ifndef SANISIZER_OVERWRITE_HPP
+#define SANISIZER_OVERWRITE_HPP
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "cast.hpp"
+#include "attest.hpp"
+#include "create.hpp"
+
+/**
+ * @file overwrite.hpp
+ * @brief Safely create storage that will be overwritten.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Allocator that default-initializes its elements.
+ *
+ * @tparam Type_ Type of the elements.
+ * @tparam Base_ Base allocator class.
+ *
+ * When a container requests value-initialization of an element, e.g., `std::vector<Type_>::resize()`, this allocator performs default-initialization instead.
+ * For trivial types like `double`, this means that the memory is left uninitialized rather than being zero-filled.
+ * This is useful for large buffers that are immediately overwritten, where the cost of the zero-filling would otherwise be wasted.
+ * Construction with arguments is passed through to `Base_` as usual.
+ */
+template<typename Type_, class Base_ = std::allocator<Type_> >
+class DefaultInitAllocator : public Base_ {
+    typedef std::allocator_traits<Base_> Traits;
+
+public:
+    /**
+     * @cond
+     */
+    template<typename Other_>
+    struct rebind {
+        typedef DefaultInitAllocator<Other_, typename Traits::template rebind_alloc<Other_> > other;
+    };
+
+    using Base_::Base_;
+
+    DefaultInitAllocator() = default;
+
+    template<typename Other_, class OtherBase_>
+    DefaultInitAllocator(const DefaultInitAllocator<Other_, OtherBase_>& other) noexcept : Base_(static_cast<const OtherBase_&>(other)) {}
+    /**
+     * @endcond
+     */
+
+    /**
+     * Default-initialize an element.
+     * @tparam Element_ Type of the element.
+     * @param ptr Pointer to the storage for the element.
+     */
+    template<typename Element_>
+    void construct(Element_* ptr) noexcept(std::is_nothrow_default_constructible<Element_>::value) {
+        ::new(static_cast<void*>(ptr)) Element_;
+    }
+
+    /**
+     * Construct an element with the supplied arguments, using the base allocator.
+     * @tparam Element_ Type of the element.
+     * @tparam Args_ Types of the arguments.
+     * @param ptr Pointer to the storage for the element.
+     * @param args Arguments to pass to the constructor.
+     */
+    template<typename Element_, typename ... Args_>
+    void construct(Element_* ptr, Args_&&... args) {
+        Traits::construct(static_cast<Base_&>(*this), ptr, std::forward<Args_>(args)...);
+    }
+};
+
+/**
+ * @cond
+ */
+template<typename Type_, class Base_>
+struct is_standard_allocator<DefaultInitAllocator<Type_, Base_> > : is_standard_allocator<Base_> {};
+/**
+ * @endcond
+ */
+
+/**
+ * A `std::vector` that default-initializes its elements, see `DefaultInitAllocator` for details.
+ * This can be used with `create()` or `resize()` to allocate large buffers without zero-filling.
+ *
+ * @tparam Type_ Type of the elements.
+ */
+template<typename Type_>
+using DefaultInitVector = std::vector<Type_, DefaultInitAllocator<Type_> >;
+
+/**
+ * Create an array with default-initialized elements, equivalent to `std::make_unique_for_overwrite()` in C++20.
+ * This protects against overflow when casting the integer size to `std::size_t` and when computing the number of bytes to allocate.
+ * As in `create()`, an error is raised if the number of bytes exceeds the maximum of `std::ptrdiff_t`.
+ *
+ * @tparam Type_ Type of the elements.
+ * @tparam Value_ Integer type of the input size.
+ * This may also be an `Attestation`.
+ *
+ * @param x Non-negative value representing the desired number of elements.
+ *
+ * @return Pointer to an array of length `x`.
+ * For trivial types like `double`, the contents are uninitialized.
+ */
+template<typename Type_, typename Value_>
+std::unique_ptr<Type_[]> create_unique_for_overwrite(Value_ x) {
+    const auto n = cast<std::size_t>(x);
+    if constexpr(as_unsigned(get_max<Value_>()) > max_elements_of_type<Type_>()) {
+        check_element_byte_size<Type_>(n, "create_unique_for_overwrite");
+    }
+    return std::unique_ptr<Type_[]>(new Type_[n]);
+}
+
+/**
+ * Create a `DefaultInitVector` of the specified size.
+ * This protects against overflow when casting the integer size to the vector's size type and when computing the number of bytes to allocate.
+ *
+ * @tparam Type_ Type of the elements.
+ * @tparam Value_ Integer type of the input size.
+ *
+ * @param x Non-negative value representing the desired number of elements.
+ *
+ * @return A vector of length `x`.
+ * For trivial types like `double`, the contents are uninitialized.
+ */
+template<typename Type_, typename Value_>
+DefaultInitVector<Type_> create_vector_for_overwrite(Value_ x) {
+    return create<DefaultInitVector<Type_> >(x);
+}
+
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef SANISIZER_PARTITION_HPP
+#define SANISIZER_PARTITION_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <type_traits>
+
+#include "attest.hpp"
+#include "cast.hpp"
+#include "arithmetic.hpp"
+
+/**
+ * @file partition.hpp
+ * @brief Overflow-safe partitioning of work across workers.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Contiguous range of tasks.
+ * @tparam Size_ Integer type of the number of tasks.
+ */
+template<typename Size_>
+struct Range {
+    /**
+     * Index of the first task in the range.
+     */
+    Size_ start;
+
+    /**
+     * Number of tasks in the range.
+     */
+    Size_ length;
+};
+
+/**
+ * @cond
+ */
+template<typename Worker_, typename Size_, typename Value_>
+Worker_ validate_workers(Value_ workers) {
+    static_assert(std::is_integral<Worker_>::value);
+    if (get_value(workers) <= 0) {
+        throw std::domain_error("number of workers should be positive in sanisizer::partition");
+    }
+    cast<Size_>(workers);
+    return cast<Worker_>(workers);
+}
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Partition tasks into contiguous chunks of balanced size.
+ *
+ * @tparam Size_ Integer type of the number of tasks.
+ * @tparam Worker_ Integer type of the worker index, e.g., `int` for OpenMP threads or MPI ranks.
+ *
+ * Each of the `n` tasks is assigned to one of `k` workers such that each worker receives a contiguous range of tasks.
+ * The lengths of the ranges differ by at most 1, with the first `n % k` workers receiving an extra task.
+ * The number of workers is validated upon construction so that any worker index can be safely used as a `Worker_` or `Size_`,
+ * and the range for each worker is computed in constant time without any possibility of overflow.
+ */
+template<typename Size_, typename Worker_ = int>
+class ContiguousPartition {
+    static_assert(std::is_integral<Size_>::value);
+
+public:
+    /**
+     * @tparam Tasks_ Integer type of the number of tasks.
+     * This may also be an `Attestation`.
+     * @tparam Workers_ Integer type of the number of workers.
+     * This may also be an `Attestation`.
+     *
+     * @param tasks Non-negative number of tasks.
+     * @param workers Positive number of workers.
+     * An error is raised if this is not positive or cannot be represented in `Size_` or `Worker_`.
+     */
+    template<typename Tasks_, typename Workers_>
+    ContiguousPartition(Tasks_ tasks, Workers_ workers) :
+        my_tasks(cast<Size_>(tasks)),
+        my_workers(validate_workers<Worker_, Size_>(workers)),
+        my_base(my_tasks / static_cast<Size_>(my_workers)),
+        my_remainder(my_tasks % static_cast<Size_>(my_workers))
+    {}
+
+public:
+    /**
+     * @return Number of tasks.
+     */
+    Size_ num_tasks() const {
+        return my_tasks;
+    }
+
+    /**
+     * @return Number of workers.
+     */
+    Worker_ num_workers() const {
+        return my_workers;
+    }
+
+    /**
+     * @param worker Index of the worker, less than `num_workers()`.
+     * @return Range of tasks assigned to `worker`.
+     * This may be empty if there are more workers than tasks.
+     */
+    Range<Size_> range(Worker_ worker) const {
+        assert(worker >= 0 && worker < my_workers);
+        const Size_ w = worker;
+        // The first 'my_remainder' workers get an extra task, so their starts are shifted by their own index.
+        // This cannot overflow as the start of any worker is no greater than the number of tasks.
+        const Size_ extra = (w < my_remainder ? w : my_remainder);
+        return Range<Size_>{ static_cast<Size_>(w * my_base + extra), static_cast<Size_>(my_base + (w < my_remainder)) };
+    }
+
+    /**
+     * @param task Index of the task, less than `num_tasks()`.
+     * @return Index of the worker that is assigned to `task`.
+     */
+    Worker_ owner(Size_ task) const {
+        assert(task >= 0 && task < my_tasks);
+        const Size_ boundary = my_remainder * (my_base + 1); // number of tasks assigned to the workers with an extra task.
+        if (task < boundary) {
+            return task / (my_base + 1);
+        } else {
+            return my_remainder + (task - boundary) / my_base;
+        }
+    }
+
+private:
+    Size_ my_tasks;
+    Worker_ my_workers;
+    Size_ my_base, my_remainder;
+};
+
+/**
+ * @brief Partition tasks into blocks of fixed size.
+ *
+ * @tparam Size_ Integer type of the number of tasks.
+ *
+ * The `n` tasks are split into contiguous blocks of size `b`, where the last block may be shorter.
+ * The number of blocks and the range of each block is computed without any possibility of overflow, even if `n` is close to the maximum of `Size_`.
+ */
+template<typename Size_>
+class BlockPartition {
+    static_assert(std::is_integral<Size_>::value);
+
+public:
+    /**
+     * @tparam Tasks_ Integer type of the number of tasks.
+     * This may also be an `Attestation`.
+     * @tparam Block_ Integer type of the block size.
+     * This may also be an `Attestation`.
+     *
+     * @param tasks Non-negative number of tasks.
+     * @param block_size Positive size of each block.
+     * An error is raised if this is zero.
+     */
+    template<typename Tasks_, typename Block_>
+    BlockPartition(Tasks_ tasks, Block_ block_size) :
+        my_tasks(cast<Size_>(tasks)),
+        my_block_size(cast<Size_>(block_size)),
+        my_blocks(get_value(ceil_divide<Size_>(my_tasks, my_block_size)))
+    {}
+
+public:
+    /**
+     * @return Number of tasks.
+     */
+    Size_ num_tasks() const {
+        return my_tasks;
+    }
+
+    /**
+     * @return Size of each block.
+     */
+    Size_ block_size() const {
+        return my_block_size;
+    }
+
+    /**
+     * @return Number of blocks.
+     */
+    Size_ num_blocks() const {
+        return my_blocks;
+    }
+
+    /**
+     * @param block Index of the block, less than `num_blocks()`.
+     * @return Range of tasks in `block`.
+     */
+    Range<Size_> range(Size_ block) const {
+        assert(block >= 0 && block < my_blocks);
+        // This cannot overflow as the start of any block is less than the number of tasks.
+        const Size_ start = block * my_block_size;
+        const Size_ remaining = my_tasks - start;
+        return Range<Size_>{ start, (remaining < my_block_size ? remaining : my_block_size) };
+    }
+
+    /**
+     * @param task Index of the task, less than `num_tasks()`.
+     * @return Index of the block containing `task`.
+     */
+    Size_ owner(Size_ task) const {
+        assert(task >= 0 && task < my_tasks);
+        return task / my_block_size;
+    }
+
+private:
+    Size_ my_tasks, my_block_size, my_blocks;
+};
+
+/**
+ * @brief Assign blocks of tasks to workers in a cyclic manner.
+ *
+ * @tparam Size_ Integer type of the number of tasks.
+ * @tparam Worker_ Integer type of the worker index, e.g., `int` for OpenMP threads or MPI ranks.
+ *
+ * The `n` tasks are split into blocks of size `b` as described in `BlockPartition`, and block `i` is assigned to worker `i % k`.
+ * This provides better load balancing than `ContiguousPartition` when the cost of each task is variable.
+ * As with `ContiguousPartition`, the number of workers is validated upon construction so that all subsequent calculations are overflow-free.
+ */
+template<typename Size_, typename Worker_ = int>
+class BlockCyclicPartition {
+    static_assert(std::is_integral<Size_>::value);
+
+public:
+    /**
+     * @tparam Tasks_ Integer type of the number of tasks.
+     * This may also be an `Attestation`.
+     * @tparam Block_ Integer type of the block size.
+     * This may also be an `Attestation`.
+     * @tparam Workers_ Integer type of the number of workers.
+     * This may also be an `Attestation`.
+     *
+     * @param tasks Non-negative number of tasks.
+     * @param block_size Positive size of each block.
+     * @param workers Positive number of workers.
+     */
+    template<typename Tasks_, typename Block_, typename Workers_>
+    BlockCyclicPartition(Tasks_ tasks, Block_ block_size, Workers_ workers) :
+        my_blocks(tasks, block_size),
+        my_workers(validate_workers<Worker_, Size_>(workers))
+    {}
+
+public:
+    /**
+     * @return The underlying partition of tasks into blocks.
+     */
+    const BlockPartition<Size_>& blocks() const {
+        return my_blocks;
+    }
+
+    /**
+     * @return Number of workers.
+     */
+    Worker_ num_workers() const {
+        return my_workers;
+    }
+
+    /**
+     * @param worker Index of the worker, less than `num_workers()`.
+     * @return Number of blocks assigned to `worker`.
+     */
+    Size_ num_blocks(Worker_ worker) const {
+        assert(worker >= 0 && worker < my_workers);
+        const Size_ nblocks = my_blocks.num_blocks();
+        const Size_ k = my_workers;
+        return nblocks / k + (static_cast<Size_>(worker) < nblocks % k);
+    }
+
+    /**
+     * @param worker Index of the worker, less than `num_workers()`.
+     * @param i Index of the block within the set of blocks assigned to `worker`, less than `num_blocks(worker)`.
+     * @return Range of tasks in the `i`-th block assigned to `worker`.
+     */
+    Range<Size_> range(Worker_ worker, Size_ i) const {
+        assert(i >= 0 && i < num_blocks(worker));
+        // This cannot overflow as the index of any assigned block is less than the total number of blocks.
+        return my_blocks.range(static_cast<Size_>(worker) + i * static_cast<Size_>(my_workers));
+    }
+
+    /**
+     * @param task Index of the task, less than the number of tasks.
+     * @return Index of the worker that is assigned to `task`.
+     */
+    Worker_ owner(Size_ task) const {
+        assert(task >= 0 && task < my_blocks.num_tasks());
+        return my_blocks.owner(task) % static_cast<Size_>(my_workers);
+    }
+
+private:
+    BlockPartition<Size_> my_blocks;
+    Worker_ my_workers;
+};
+
+}
+
+#endif
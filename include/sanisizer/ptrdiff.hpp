@@ -1,6 +1,7 @@
 #ifndef SANISIZER_PTRDIFF_HPP
 #define SANISIZER_PTRDIFF_HPP
 
+#include <cassert>
 #include <utility>
 
 #include "attest.hpp"
@@ -38,6 +39,117 @@ constexpr bool can_ptrdiff(MaxDiff_ max_diff) {
 // This comes at the theoretical cost of more false-positive errors if the differences could otherwise fit,
 // but it's hard to imagine a case where we could guarantee that 'end - start' would never reach 'max_diff'... because then we could just set a lower 'max_diff'.
 
+/**
+ * @brief Iterator range with overflow-free differences.
+ *
+ * @tparam Iterator_ Random-access iterator or pointer.
+ *
+ * This applies the `can_ptrdiff()` check once upon construction, based on the length of the range.
+ * All subsequent offsets and differences between iterators in the range can then be computed without further checks,
+ * allowing tight loops over custom iterators to skip per-step checks.
+ * The same guarantee is inherited by any sub-range created by `subrange()`.
+ */
+template<typename Iterator_>
+class PtrdiffRange {
+public:
+    /**
+     * Difference type of `Iterator_`.
+     */
+    typedef I<decltype(std::declval<Iterator_>() - std::declval<Iterator_>())> Difference;
+
+    /**
+     * @tparam Length_ Integer type of the length.
+     * This may also be an `Attestation`.
+     *
+     * @param begin Iterator to the start of the range.
+     * @param length Non-negative length of the range.
+     * An error is raised if this cannot be represented in `Difference`.
+     */
+    template<typename Length_>
+    PtrdiffRange(Iterator_ begin, Length_ length) : my_begin(begin), my_length(validate(length)) {}
+
+private:
+    template<typename Length_>
+    static Difference validate(Length_ length) {
+        can_ptrdiff<Iterator_>(length);
+        return get_value(length);
+    }
+
+    struct Unchecked {};
+    PtrdiffRange(Iterator_ begin, Difference length, Unchecked) : my_begin(begin), my_length(length) {}
+
+public:
+    /**
+     * @return Iterator to the start of the range.
+     */
+    Iterator_ begin() const {
+        return my_begin;
+    }
+
+    /**
+     * @return Iterator to the end of the range.
+     */
+    Iterator_ end() const {
+        return my_begin + my_length;
+    }
+
+    /**
+     * @return Length of the range, i.e., `end() - begin()`.
+     */
+    Difference size() const {
+        return my_length;
+    }
+
+    /**
+     * @return Whether the range is empty.
+     */
+    bool empty() const {
+        return my_length == 0;
+    }
+
+    /**
+     * @param k Offset from the start of the range, no greater than `size()`.
+     * @return Iterator to position `k`, i.e., `begin() + k`.
+     */
+    Iterator_ at(Difference k) const {
+        assert(k >= 0 && k <= my_length);
+        return my_begin + k;
+    }
+
+    /**
+     * @param it Iterator in the range, i.e., between `begin()` and `end()` inclusive.
+     * @return Offset of `it` from the start of the range, i.e., `it - begin()`.
+     */
+    Difference offset(Iterator_ it) const {
+        return it - my_begin;
+    }
+
+    /**
+     * @param start Offset of the start of the sub-range, no greater than `size()`.
+     * @param length Length of the sub-range, no greater than `size() - start`.
+     * @return Sub-range of this range.
+     * No check is performed as the length of the sub-range is no greater than that of this range.
+     */
+    PtrdiffRange subrange(Difference start, Difference length) const {
+        assert(start >= 0 && start <= my_length);
+        assert(length >= 0 && length <= my_length - start);
+        return PtrdiffRange(my_begin + start, length, Unchecked());
+    }
+
+    /**
+     * @param start Offset of the start of the sub-range, no greater than `size()`.
+     * @return Sub-range from `start` to the end of this range.
+     */
+    PtrdiffRange subrange(Difference start) const {
+        assert(start >= 0 && start <= my_length);
+        return PtrdiffRange(my_begin + start, my_length - start, Unchecked());
+    }
+
+private:
+    Iterator_ my_begin;
+    Difference my_length;
+};
+
 }
 
 #endif
@@ -6,11 +6,20 @@
 #include "attest.hpp"
 #include "comparisons.hpp"
 #include "create.hpp"
+#include "overwrite.hpp"
+#include "arena.hpp"
+#include "growth.hpp"
+#include "budget.hpp"
+#include "partition.hpp"
 #include "nd_offset.hpp"
+#include "shape.hpp"
+#include "odometer.hpp"
+#include "extents.hpp"
 #include "cap.hpp"
 #include "ptrdiff.hpp"
 #include "float.hpp"
 #include "class.hpp"
+#include "accumulator.hpp"
 
 /**
  * @file sanisizer.hpp
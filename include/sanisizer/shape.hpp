@@ -0,0 +1,212 @@
+#ifndef SANISIZER_SHAPE_HPP
+#define SANISIZER_SHAPE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+#include "attest.hpp"
+#include "cast.hpp"
+#include "utils.hpp"
+#include "arithmetic.hpp"
+
+/**
+ * @file shape.hpp
+ * @brief Validated shape of an N-dimensional array.
+ */
+
+namespace sanisizer {
+
+/**
+ * @brief Validated shape of an N-dimensional array.
+ *
+ * @tparam Size_ Integer type to represent the size of the flattened array.
+ * @tparam ndim_ Number of dimensions.
+ *
+ * The product of the extents is checked for overflow in `Size_` once, upon construction.
+ * The strides for each dimension are then cached so that `offset()` is a simple multiply-add without any further checks.
+ * As in `nd_offset()`, the first dimension is assumed to be the fastest-changing, followed by the second dimension, and so on.
+ */
+template<typename Size_, std::size_t ndim_>
+class Shape {
+    static_assert(std::is_integral<Size_>::value);
+    static_assert(ndim_ > 0);
+
+    std::array<Size_, ndim_> my_extents, my_strides;
+    Size_ my_size;
+
+public:
+    /**
+     * @tparam Extents_ Integer types of the extents.
+     * Any of these may also be `Attestation`s.
+     * @param extents Non-negative extent of each dimension.
+     * This should have length equal to `ndim_`.
+     *
+     * An error is raised if any extent, stride or the product of all extents overflows `Size_`, see `cast()` and `product()` for details.
+     */
+    template<typename ... Extents_>
+    constexpr Shape(Extents_... extents) : my_extents{}, my_strides{}, my_size(1) {
+        static_assert(sizeof...(Extents_) == ndim_);
+        std::size_t d = 0;
+        ((my_strides[d] = my_size, my_extents[d] = cast<Size_>(extents), my_size = product<Size_>(my_size, my_extents[d]), ++d), ...);
+    }
+
+public:
+    /**
+     * @return Number of dimensions.
+     */
+    static constexpr std::size_t ndim() {
+        return ndim_;
+    }
+
+    /**
+     * @return Total number of elements in the array, i.e., the product of the extents.
+     */
+    constexpr Size_ size() const {
+        return my_size;
+    }
+
+    /**
+     * @param d Index of the dimension.
+     * @return Extent of dimension `d`.
+     */
+    constexpr Size_ extent(std::size_t d) const {
+        return my_extents[d];
+    }
+
+    /**
+     * @param d Index of the dimension.
+     * @return Stride of dimension `d`, i.e., the product of the extents of all previous dimensions.
+     * This is guaranteed to be representable in `Size_`.
+     */
+    constexpr Size_ stride(std::size_t d) const {
+        return my_strides[d];
+    }
+
+    /**
+     * @return Extents of all dimensions.
+     */
+    constexpr const std::array<Size_, ndim_>& extents() const {
+        return my_extents;
+    }
+
+    /**
+     * @return Strides of all dimensions.
+     */
+    constexpr const std::array<Size_, ndim_>& strides() const {
+        return my_strides;
+    }
+
+public:
+    /**
+     * Compute the offset for an element of the flattened array.
+     * No overflow checks are performed as the offset is guaranteed to be less than `size()` for valid indices.
+     *
+     * @tparam Indices_ Integer types of the indices.
+     * It is assumed that these can be safely cast to `Size_`.
+     * @param indices Position of the element on each dimension.
+     * This should have length equal to `ndim_`, and each index should be less than the extent of its dimension.
+     *
+     * @return Offset into the array for the element at `indices`.
+     */
+    template<typename ... Indices_>
+    constexpr Size_ offset(Indices_... indices) const {
+        static_assert(sizeof...(Indices_) == ndim_);
+        Size_ output = 0;
+        std::size_t d = 0;
+        ((assert(static_cast<Size_>(get_value(indices)) < my_extents[d]), output += static_cast<Size_>(get_value(indices)) * my_strides[d], ++d), ...);
+        return output;
+    }
+
+    /**
+     * Compute offsets for a batch of elements, given their coordinates in a structure-of-arrays layout.
+     * This is equivalent to calling `offset()` on each element but the loop is free of branches so that the compiler can vectorize it.
+     * No overflow checks are performed, see `offsets_validated()` for a version that checks the coordinates.
+     *
+     * @tparam Length_ Integer type of the number of elements.
+     * @tparam Coordinate_ Random-access iterator that dereferences to an integer.
+     * It is assumed that the integer can be safely cast to `Size_`.
+     * @tparam Output_ Random-access iterator to an integer type that can hold any offset.
+     *
+     * @param n Number of elements.
+     * @param coordinates Coordinates of the elements for each dimension.
+     * For dimension `d`, `coordinates[d]` should point to an array of length `n` containing the position of each element on that dimension.
+     * Each position should be less than the extent of `d`.
+     * @param[out] output Pointer to an array of length `n`.
+     * On output, this is filled with the offset of each element.
+     */
+    template<typename Length_, typename Coordinate_, typename Output_>
+    void offsets(Length_ n, const std::array<Coordinate_, ndim_>& coordinates, Output_ output) const {
+        offsets_internal(n, coordinates, output, std::make_index_sequence<ndim_>());
+    }
+
+    /**
+     * Compute offsets for a batch of elements, validating each coordinate against the extent of its dimension.
+     * Invalid coordinates are reported in bulk instead of throwing an error for each element, 
+     * and the loop is still free of branches so that the compiler can vectorize it.
+     *
+     * @tparam Length_ Integer type of the number of elements.
+     * @tparam Coordinate_ Random-access iterator that dereferences to an integer.
+     * @tparam Output_ Random-access iterator to an integer type that can hold any value up to `size()`.
+     *
+     * @param n Number of elements.
+     * @param coordinates Coordinates of the elements for each dimension, see `offsets()`.
+     * Positions may be negative or greater than or equal to the extent of their dimension.
+     * @param[out] output Pointer to an array of length `n`.
+     * On output, this is filled with the offset of each element.
+     * For elements with any invalid coordinate, the offset is set to `size()`, 
+     * which can be used to locate the first invalid element, e.g., with `std::find()`.
+     *
+     * @return Number of elements with at least one invalid coordinate.
+     */
+    template<typename Length_, typename Coordinate_, typename Output_>
+    Length_ offsets_validated(Length_ n, const std::array<Coordinate_, ndim_>& coordinates, Output_ output) const {
+        return offsets_validated_internal(n, coordinates, output, std::make_index_sequence<ndim_>());
+    }
+
+private:
+    // The dimensions are unrolled with fold expressions as compilers do not always unroll the inner loop at -O2.
+    // Local copies of the strides and coordinate pointers also ensure that these are not reloaded in case of aliasing with 'output'.
+    template<typename Length_, typename Coordinate_, typename Output_, std::size_t ... d_>
+    void offsets_internal(Length_ n, const std::array<Coordinate_, ndim_>& coordinates, Output_ output, std::index_sequence<d_...>) const {
+        const auto strides = my_strides;
+        const auto coords = coordinates;
+        for (Length_ i = 0; i < n; ++i) {
+            output[i] = ((static_cast<Size_>(get_value(coords[d_][i])) * strides[d_]) + ...);
+        }
+    }
+
+    template<typename Value_>
+    static constexpr bool coordinate_valid(Value_ val, Size_ extent) {
+        if constexpr(std::is_signed<Value_>::value) {
+            return (val >= 0) & (as_unsigned(val) < as_unsigned(extent));
+        } else {
+            return as_unsigned(val) < as_unsigned(extent);
+        }
+    }
+
+    template<typename Length_, typename Coordinate_, typename Output_, std::size_t ... d_>
+    Length_ offsets_validated_internal(Length_ n, const std::array<Coordinate_, ndim_>& coordinates, Output_ output, std::index_sequence<d_...>) const {
+        // Offsets are accumulated in the unsigned type so that invalid coordinates do not cause signed overflow.
+        typedef I<decltype(as_unsigned(my_size))> Unsigned;
+        const auto extents = my_extents;
+        const auto strides = my_strides;
+        const auto size = my_size;
+        const auto coords = coordinates;
+
+        Length_ num_invalid = 0;
+        for (Length_ i = 0; i < n; ++i) {
+            const bool valid = (coordinate_valid(get_value(coords[d_][i]), extents[d_]) & ...);
+            const Unsigned current = ((static_cast<Unsigned>(get_value(coords[d_][i])) * static_cast<Unsigned>(strides[d_])) + ...);
+            output[i] = (valid ? static_cast<Size_>(current) : size);
+            num_invalid += !valid;
+        }
+        return num_invalid;
+    }
+};
+
+}
+
+#endif
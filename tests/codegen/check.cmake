@@ -0,0 +1,59 @@
+# Inspects the disassembly of the functions in functions.cpp.
+# Functions prefixed with 'elided_' should not contain any branches or calls, 
+# while those prefixed with 'checked_' should contain at least one.
+# This expects OBJDUMP and OBJECT to be defined on the command line.
+
+execute_process(
+    COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE status
+)
+if(NOT status EQUAL 0)
+    message(FATAL_ERROR "failed to disassemble '${OBJECT}'")
+endif()
+
+string(REPLACE ";" "\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+
+set(current "")
+set(num_elided 0)
+set(num_checked 0)
+set(failures "")
+
+# Any jump or call counts as a branch. We check the functions when we reach the header of the next one.
+macro(finish_function)
+    if(current MATCHES "^elided_")
+        math(EXPR num_elided "${num_elided} + 1")
+        if(branches)
+            list(APPEND failures "${current} has branches or calls:${branches}")
+        endif()
+    elseif(current MATCHES "^checked_")
+        math(EXPR num_checked "${num_checked} + 1")
+        if(NOT branches)
+            list(APPEND failures "${current} has no branches or calls")
+        endif()
+    endif()
+endmacro()
+
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <([A-Za-z0-9_.]+)>:")
+        set(next "${CMAKE_MATCH_1}")
+        finish_function()
+        set(current "${next}")
+        set(branches "")
+    elseif(line MATCHES "^ +[0-9a-f]+:[ \t]+((j[a-z]+|call[a-z]*)[ \t].*)$")
+        string(APPEND branches "\n    ${CMAKE_MATCH_1}")
+    endif()
+endforeach()
+finish_function()
+
+if(num_elided EQUAL 0 OR num_checked EQUAL 0)
+    message(FATAL_ERROR "no functions found in the disassembly of '${OBJECT}'")
+endif()
+
+if(failures)
+    string(REPLACE ";" "\n" failures "${failures}")
+    message(FATAL_ERROR "${failures}")
+endif()
+
+message(STATUS "checked ${num_elided} elided and ${num_checked} checked functions")
@@ -0,0 +1,115 @@
+#include "sanisizer/sanisizer.hpp"
+
+#include <cstdint>
+
+/*
+ * Functions for which the overflow checks should be elided at compile time.
+ * Each of these should compile down to straight-line code without any branches or calls, see check.cmake.
+ * The 'checked_' functions are positive controls to make sure that the disassembly is actually being inspected.
+ */
+
+typedef sanisizer::Attestation<std::uint64_t, 1000> Attested1000;
+
+extern "C" {
+
+std::uint64_t elided_cast_uint64_uint32(std::uint32_t x) {
+    return sanisizer::cast<std::uint64_t>(x);
+}
+
+std::int64_t elided_cast_int64_int32(std::int32_t x) {
+    return sanisizer::cast<std::int64_t>(x);
+}
+
+std::uint16_t elided_cast_uint16_attested(std::uint64_t x) {
+    return sanisizer::cast<std::uint16_t>(Attested1000(x));
+}
+
+std::uint64_t elided_cap_uint64_uint32(std::uint32_t x) {
+    return sanisizer::cap<std::uint64_t>(x);
+}
+
+std::uint64_t elided_sum_uint64_uint32(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::sum<std::uint64_t>(x, y);
+}
+
+std::uint16_t elided_sum_uint16_attested(std::uint64_t x, std::uint64_t y) {
+    return sanisizer::sum<std::uint16_t>(Attested1000(x), Attested1000(y));
+}
+
+std::uint64_t elided_product_uint64_uint32(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::product<std::uint64_t>(x, y);
+}
+
+std::uint32_t elided_product_uint32_attested(std::uint64_t x, std::uint64_t y) {
+    return sanisizer::product<std::uint32_t>(Attested1000(x), Attested1000(y));
+}
+
+std::uint64_t elided_try_cast_uint64_uint32(std::uint32_t x) {
+    return sanisizer::try_cast<std::uint64_t>(x).value_or(0);
+}
+
+std::uint64_t elided_try_sum_uint64_uint32(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::try_sum<std::uint64_t>(x, y).value_or(0);
+}
+
+std::uint32_t elided_try_product_uint32_attested(std::uint64_t x, std::uint64_t y) {
+    return sanisizer::try_product<std::uint32_t>(Attested1000(x), Attested1000(y)).value_or(0);
+}
+
+std::uint64_t elided_difference_attested(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::difference<std::uint64_t>(
+        sanisizer::Attestation<std::uint32_t, 2000, 1000>(x),
+        sanisizer::Attestation<std::uint32_t, 1000>(y)
+    );
+}
+
+std::int16_t elided_ceil_divide_attested(std::uint32_t n, std::uint32_t b) {
+    auto nblocks = sanisizer::ceil_divide<std::uint32_t>(
+        sanisizer::Attestation<std::uint32_t, 1000000>(n),
+        sanisizer::Attestation<std::uint32_t, 1000000, 1000>(b)
+    );
+    return sanisizer::cast<std::int16_t>(nblocks);
+}
+
+std::uint64_t elided_align_up_uint64_uint32(std::uint32_t x) {
+    return sanisizer::align_up<std::uint64_t, 64>(x).value;
+}
+
+std::uint32_t elided_product_min_attested(std::uint64_t x, std::uint64_t y) {
+    typedef sanisizer::Attestation<std::uint64_t, 4096> Attested4096;
+    return sanisizer::product<std::uint32_t>(sanisizer::min_attested(x, Attested4096(4096)), sanisizer::min_attested(y, Attested4096(4096)));
+}
+
+std::size_t elided_shape_offset(const sanisizer::Shape<std::size_t, 3>& shape, std::size_t i, std::size_t j, std::size_t k) {
+    return shape.offset(i, j, k);
+}
+
+std::size_t elided_extents_offset(const sanisizer::Extents<std::size_t, 3, 4, sanisizer::dynamic_extent, sanisizer::dynamic_extent>& ext, std::size_t i, std::size_t j, std::size_t k, std::size_t l) {
+    return ext.offset(i, j, k, l);
+}
+
+const double* elided_ptrdiff_range_subrange(const sanisizer::PtrdiffRange<const double*>& range, std::ptrdiff_t start, std::ptrdiff_t length) {
+    return range.subrange(start, length).end();
+}
+
+std::uint8_t checked_cast_uint8_uint32(std::uint32_t x) {
+    return sanisizer::cast<std::uint8_t>(x);
+}
+
+std::uint32_t checked_sum_uint32_uint32(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::sum<std::uint32_t>(x, y);
+}
+
+std::uint32_t checked_difference_uint32_uint32(std::uint32_t x, std::uint32_t y) {
+    return sanisizer::difference<std::uint32_t>(x, y);
+}
+
+std::uint64_t checked_align_up_uint64_uint64(std::uint64_t x) {
+    return sanisizer::align_up<std::uint64_t, 64>(x).value;
+}
+
+std::uint64_t checked_product_uint64_uint64(std::uint64_t x, std::uint64_t y) {
+    return sanisizer::product<std::uint64_t>(x, y);
+}
+
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/accumulator.hpp"
+
+#include <cstdint>
+#include <vector>
+
+TEST(Accumulator, Basic) {
+    sanisizer::Accumulator<std::uint8_t> acc;
+    EXPECT_FALSE(acc.overflowed());
+    EXPECT_EQ(acc.value(), 0);
+
+    acc.add(10).multiply(5).add(sanisizer::Attestation<int, 10>(5));
+    EXPECT_FALSE(acc.overflowed());
+    EXPECT_EQ(acc.value(), 55);
+    EXPECT_EQ(*acc.try_value(), 55);
+
+    sanisizer::Accumulator<std::int64_t> acc2(100u);
+    acc2.multiply(1000).add(1);
+    EXPECT_EQ(acc2.value(), 100001);
+
+    // Works at compile time.
+    static_assert(sanisizer::Accumulator<int>(5).add(10).multiply(2).value() == 30);
+}
+
+TEST(Accumulator, Sticky) {
+    sanisizer::Accumulator<std::uint8_t> acc(200);
+    acc.add(100);
+    EXPECT_TRUE(acc.overflowed());
+    EXPECT_FALSE(acc.try_value().has_value());
+
+    // Flag persists after subsequent operations that would not overflow by themselves.
+    acc.multiply(0).add(1);
+    EXPECT_TRUE(acc.overflowed());
+
+    bool failed = false;
+    try {
+        acc.value();
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Overflow in the initial value or in the cast of each input is also detected.
+    EXPECT_TRUE(sanisizer::Accumulator<std::uint8_t>(256).overflowed());
+    EXPECT_TRUE(sanisizer::Accumulator<std::uint8_t>().add(256).overflowed());
+    EXPECT_TRUE(sanisizer::Accumulator<std::uint8_t>().multiply(256).overflowed());
+    EXPECT_TRUE(sanisizer::Accumulator<std::uint8_t>(20).multiply(20).overflowed());
+}
+
+TEST(Accumulator, Loop) {
+    std::vector<std::uint32_t> extents{ 10, 20, 30 };
+    std::vector<std::uint32_t> indices{ 1, 2, 3 };
+    sanisizer::Accumulator<std::uint64_t> offset;
+    for (std::size_t d = extents.size(); d > 0; --d) {
+        offset.multiply(extents[d - 1]).add(indices[d - 1]);
+    }
+    EXPECT_EQ(offset.value(), 1 + 10 * (2 + 20 * 3));
+
+    std::vector<std::uint64_t> big(10, 1000000);
+    sanisizer::Accumulator<std::uint64_t> total(1);
+    for (auto b : big) {
+        total.multiply(b);
+    }
+    EXPECT_TRUE(total.overflowed());
+}
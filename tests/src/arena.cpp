@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/arena.hpp"
+#include "sanisizer/create.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include <memory_resource>
+
+TEST(Arena, Basic) {
+    sanisizer::Arena arena(1000);
+    EXPECT_EQ(arena.capacity(), 1000);
+    EXPECT_EQ(arena.used(), 0);
+
+    void* first = arena.allocate(10, 1);
+    EXPECT_EQ(arena.used(), 10);
+    void* second = arena.allocate(8, 8);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 8, 0);
+    EXPECT_GE(static_cast<unsigned char*>(second) - static_cast<unsigned char*>(first), 10);
+    EXPECT_EQ(arena.available(), 1000 - arena.used());
+
+    // Over-aligned requests are respected.
+    void* third = arena.allocate(1, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(third) % 64, 0);
+
+    // Deallocation is a no-op.
+    const auto used = arena.used();
+    arena.deallocate(third, 1, 64);
+    EXPECT_EQ(arena.used(), used);
+
+    arena.release();
+    EXPECT_EQ(arena.used(), 0);
+    EXPECT_EQ(arena.allocate(10, 1), first);
+}
+
+TEST(Arena, Exhaustion) {
+    std::vector<unsigned char> buffer(100);
+    sanisizer::Arena arena(buffer.data(), buffer.size());
+    static_cast<void>(arena.allocate(100, 1));
+    EXPECT_EQ(arena.available(), 0);
+
+    bool failed = false;
+    try {
+        static_cast<void>(arena.allocate(1, 1));
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Hostile sizes do not wrap around the bump pointer.
+    arena.release();
+    static_cast<void>(arena.allocate(1, 1));
+    failed = false;
+    try {
+        static_cast<void>(arena.allocate(std::numeric_limits<std::size_t>::max(), 1));
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(arena.used(), 1);
+
+    failed = false;
+    try {
+        static_cast<void>(arena.allocate(std::numeric_limits<std::size_t>::max() - 10, 1));
+    } catch (std::exception& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(arena.used(), 1);
+}
+
+TEST(Arena, Pmr) {
+    sanisizer::Arena arena(1000);
+    std::pmr::vector<int> vec(&arena);
+    vec.resize(10);
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_GE(arena.used(), 10 * sizeof(int));
+
+    auto created = sanisizer::create<std::pmr::vector<double> >(20, &arena);
+    EXPECT_EQ(created.size(), 20);
+    EXPECT_EQ(created.get_allocator().resource(), &arena);
+
+    EXPECT_TRUE(arena.is_equal(arena));
+    sanisizer::Arena other(10);
+    EXPECT_FALSE(arena.is_equal(other));
+}
+
+TEST(ArenaAllocator, Basic) {
+    sanisizer::Arena arena(1000);
+    sanisizer::ArenaAllocator<int> alloc(arena);
+    EXPECT_EQ(alloc.max_size(), 1000 / sizeof(int));
+
+    typedef std::vector<int, sanisizer::ArenaAllocator<int> > ArenaVector;
+    auto vec = sanisizer::create<ArenaVector>(10, 5, alloc);
+    EXPECT_EQ(vec.size(), 10);
+    EXPECT_EQ(vec.front(), 5);
+    EXPECT_EQ(arena.used(), 10 * sizeof(int));
+
+    sanisizer::reserve(vec, 20);
+    EXPECT_EQ(vec.capacity(), 20);
+
+    // Fails quickly if the arena cannot possibly satisfy the request.
+    const auto used = arena.used();
+    bool failed = false;
+    try {
+        sanisizer::create<ArenaVector>(1000, alloc);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(arena.used(), used);
+
+    failed = false;
+    try {
+        sanisizer::resize(vec, 1000);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Otherwise, the allocation itself fails if the remaining space is insufficient.
+    EXPECT_EQ(alloc.max_size(), 1000 / sizeof(int));
+    failed = false;
+    try {
+        sanisizer::resize(vec, 240);
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(vec.size(), 10);
+
+    // Rebinding works and compares equal.
+    sanisizer::ArenaAllocator<double> dalloc(alloc);
+    EXPECT_TRUE(dalloc == alloc);
+    sanisizer::Arena other(10);
+    EXPECT_TRUE(sanisizer::ArenaAllocator<int>(other) != alloc);
+}
+
+TEST(ArenaAllocator, PushBack) {
+    sanisizer::Arena arena(1000);
+    std::vector<int, sanisizer::ArenaAllocator<int> > vec{ sanisizer::ArenaAllocator<int>(arena) };
+
+    bool failed = false;
+    try {
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back(i);
+        }
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_LE(arena.used(), 1000);
+    EXPECT_GT(vec.size(), 0);
+    for (int i = 0, end = vec.size(); i < end; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+}
@@ -1,13 +1,37 @@
 #include <gtest/gtest.h>
 
 #include "sanisizer/arithmetic.hpp"
+#include "sanisizer/cast.hpp"
 
 #include <cstdint>
+#include <limits>
+#include <vector>
+#include <list>
+#include <array>
+#include <cstddef>
 
 // For brevity.
 typedef std::int32_t i32;
 typedef std::uint32_t u32;
 
+TEST(Sum, Overflows) {
+    std::uint8_t u8out = 0;
+    EXPECT_FALSE(sanisizer::add_overflows<std::uint8_t>(200, 55, u8out));
+    EXPECT_EQ(u8out, 255);
+    EXPECT_TRUE(sanisizer::add_overflows<std::uint8_t>(200, 56, u8out));
+
+    std::int8_t i8out = 0;
+    EXPECT_FALSE(sanisizer::add_overflows<std::int8_t>(100, 27, i8out));
+    EXPECT_EQ(i8out, 127);
+    EXPECT_TRUE(sanisizer::add_overflows<std::int8_t>(100, 28, i8out));
+
+    std::int64_t i64out = 0;
+    constexpr auto i64max = std::numeric_limits<std::int64_t>::max();
+    EXPECT_FALSE(sanisizer::add_overflows<std::int64_t>(i64max - 10, 10, i64out));
+    EXPECT_EQ(i64out, i64max);
+    EXPECT_TRUE(sanisizer::add_overflows<std::int64_t>(i64max - 10, 11, i64out));
+}
+
 TEST(Sum, Basic) {
     {
         static_assert(sanisizer::needs_sum_check<std::int64_t, std::int64_t, std::int64_t>());
@@ -72,6 +96,37 @@ TEST(Sum, Basic) {
     }
 }
 
+TEST(Sum, Minimum) {
+    typedef sanisizer::Attestation<i32, 100, 10> Bounded;
+
+    {
+        constexpr auto out = sanisizer::sum_protected<std::int64_t>(Bounded(20), Bounded(30));
+        static_assert(out.value == 50);
+        static_assert(decltype(out)::min == 20);
+        static_assert(decltype(out)::max == 200);
+    }
+
+    {
+        constexpr auto out = sanisizer::sum_protected<std::int64_t>(Bounded(20), 5);
+        static_assert(decltype(out)::min == 10);
+        constexpr auto out2 = sanisizer::sum_protected<std::int64_t>(Bounded(20), Bounded(30), Bounded(40));
+        static_assert(out2.value == 90);
+        static_assert(decltype(out2)::min == 30);
+    }
+
+    {
+        // Minimum is still propagated with run-time checks.
+        constexpr auto out = sanisizer::sum_protected<std::int8_t>(Bounded(20), Bounded(30));
+        static_assert(decltype(out)::min == 20);
+        static_assert(decltype(out)::max == 127);
+
+        // Capped if any sum would overflow.
+        typedef sanisizer::Attestation<i32, 1000, 100> BigBounded;
+        static_assert(sanisizer::sum_min<std::int8_t, BigBounded, BigBounded>() == 127);
+        static_assert(sanisizer::sum_min<std::int8_t, sanisizer::Attestation<i32, 1000, 200>, int>() == 127);
+    }
+}
+
 TEST(Sum, Unsafe) {
     EXPECT_EQ(sanisizer::sum_unsafe<std::uint8_t>((i32)5, (i32)20), 25);
     EXPECT_EQ(sanisizer::sum_unsafe<std::uint8_t>((u32)5, (i32)20), 25);
@@ -87,6 +142,112 @@ TEST(Sum, Unsafe) {
     static_assert(sanisizer::sum_unsafe<std::int64_t>((i32)5, (i32)20) == 25);
 }
 
+TEST(Sum, Try) {
+    static_assert(noexcept(sanisizer::try_sum<std::uint8_t>(1, 2)));
+
+    EXPECT_EQ(*sanisizer::try_sum<std::uint8_t>((u32)5, (i32)20), 25);
+    EXPECT_EQ(*sanisizer::try_sum<std::uint8_t>((u32)5, (u32)20, (u32)230), 255);
+    EXPECT_EQ(*sanisizer::try_sum<std::int64_t>((i32)5, (u32)20), 25);
+    EXPECT_EQ(*sanisizer::try_sum<std::int8_t>(5, sanisizer::Attestation<i32, 100>((i32)20)), 25);
+
+    EXPECT_FALSE(sanisizer::try_sum<std::uint8_t>((u32)5, (u32)20, (u32)231).has_value());
+    EXPECT_FALSE(sanisizer::try_sum<std::uint8_t>((u32)256, (u32)0).has_value());
+    EXPECT_FALSE(sanisizer::try_sum<std::uint8_t>((u32)0, (u32)256).has_value());
+    EXPECT_FALSE(sanisizer::try_sum<std::int8_t>(100, sanisizer::Attestation<i32, 1000>((i32)28)).has_value());
+
+    // Works at compile-time.
+    static_assert(*sanisizer::try_sum<std::int64_t>((i32)5, (i32)20) == 25);
+    static_assert(!sanisizer::try_sum<std::uint8_t>(200, 100).has_value());
+}
+
+TEST(Sum, Range) {
+    std::vector<std::uint8_t> small{ 1, 2, 3, 4, 5 };
+    EXPECT_EQ(sanisizer::sum_range<std::int64_t>(small.begin(), small.end()), 15);
+    EXPECT_EQ(sanisizer::sum_range<std::uint8_t>(small.begin(), small.end()), 15);
+    EXPECT_EQ(sanisizer::sum_range<std::uint8_t>(small.begin(), small.begin()), 0);
+
+    // Works with larger vectors.
+    std::vector<std::uint8_t> large(1000, 65);
+    EXPECT_EQ(sanisizer::sum_range<std::uint16_t>(large.begin(), large.end()), 65000);
+    EXPECT_EQ(sanisizer::sum_range<std::uint64_t>(large.data(), large.data() + large.size()), 65000);
+    large.resize(1010, 65);
+    {
+        bool failed = false;
+        try {
+            sanisizer::sum_range<std::uint16_t>(large.begin(), large.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Fails if any individual element cannot fit in the destination type.
+    std::vector<i32> wide{ 1, 2, 300, 4 };
+    EXPECT_EQ(sanisizer::sum_range<std::int16_t>(wide.begin(), wide.end()), 307);
+    {
+        bool failed = false;
+        try {
+            sanisizer::sum_range<std::uint8_t>(wide.begin(), wide.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Detects wrap-around when the elements are large enough.
+    std::vector<std::uint64_t> huge{ 5, 10, 20 };
+    EXPECT_EQ(sanisizer::sum_range<std::uint64_t>(huge.begin(), huge.end()), 35);
+    huge.push_back(std::numeric_limits<std::uint64_t>::max() - 30);
+    {
+        bool failed = false;
+        try {
+            sanisizer::sum_range<std::uint64_t>(huge.begin(), huge.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Works with non-random-access iterators.
+    std::list<u32> linked{ 100, 50, 90 };
+    EXPECT_EQ(sanisizer::sum_range<std::uint8_t>(linked.begin(), linked.end()), 240);
+    linked.push_back(16);
+    {
+        bool failed = false;
+        try {
+            sanisizer::sum_range<std::uint8_t>(linked.begin(), linked.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Works with attestations.
+    std::vector<sanisizer::Attestation<i32, 10> > attested{ 1, 5, 9, 10 };
+    EXPECT_EQ(sanisizer::sum_range<std::uint8_t>(attested.begin(), attested.end()), 25);
+    std::vector<sanisizer::Attestation<i32, 0> > zeroes{ 0, 0, 0 };
+    EXPECT_EQ(sanisizer::sum_range<std::uint8_t>(zeroes.begin(), zeroes.end()), 0);
+}
+
+TEST(Product, Overflows) {
+    std::uint8_t u8out = 0;
+    EXPECT_FALSE(sanisizer::mul_overflows<std::uint8_t>(15, 17, u8out));
+    EXPECT_EQ(u8out, 255);
+    EXPECT_TRUE(sanisizer::mul_overflows<std::uint8_t>(16, 16, u8out));
+    EXPECT_FALSE(sanisizer::mul_overflows<std::uint8_t>(0, 255, u8out));
+    EXPECT_EQ(u8out, 0);
+
+    std::int16_t i16out = 0;
+    EXPECT_FALSE(sanisizer::mul_overflows<std::int16_t>(181, 181, i16out));
+    EXPECT_EQ(i16out, 32761);
+    EXPECT_TRUE(sanisizer::mul_overflows<std::int16_t>(182, 181, i16out));
+
+    std::uint64_t u64out = 0;
+    EXPECT_FALSE(sanisizer::mul_overflows<std::uint64_t>(4294967296ull, 4294967295ull, u64out));
+    EXPECT_EQ(u64out, 18446744069414584320ull);
+    EXPECT_TRUE(sanisizer::mul_overflows<std::uint64_t>(4294967296ull, 4294967296ull, u64out));
+}
+
 TEST(Product, Basic) {
     {
         static_assert(sanisizer::needs_product_check<std::int64_t, std::int64_t, std::int64_t>());
@@ -170,6 +331,39 @@ TEST(Product, Basic) {
     }
 }
 
+TEST(Product, Minimum) {
+    typedef sanisizer::Attestation<i32, 100, 10> Bounded;
+
+    {
+        constexpr auto out = sanisizer::product_protected<std::int64_t>(Bounded(20), Bounded(30));
+        static_assert(out.value == 600);
+        static_assert(decltype(out)::min == 100);
+        static_assert(decltype(out)::max == 10000);
+    }
+
+    {
+        constexpr auto out = sanisizer::product_protected<std::int64_t>(Bounded(20), 5);
+        static_assert(decltype(out)::min == 0);
+        constexpr auto out2 = sanisizer::product_protected<std::int64_t>(Bounded(20), Bounded(30), Bounded(40));
+        static_assert(out2.value == 24000);
+        static_assert(decltype(out2)::min == 1000);
+    }
+
+    {
+        // Minimum is still propagated with run-time checks.
+        constexpr auto out = sanisizer::product_protected<std::int8_t>(Bounded(10), Bounded(12));
+        static_assert(out.value == 120);
+        static_assert(decltype(out)::min == 100);
+        static_assert(decltype(out)::max == 127);
+
+        // Capped if any product would overflow.
+        typedef sanisizer::Attestation<i32, 100, 20> BigBounded;
+        static_assert(sanisizer::product_min<std::int8_t, BigBounded, BigBounded>() == 127);
+        static_assert(sanisizer::product_min<std::int8_t, sanisizer::Attestation<i32, 1000, 200>, int>() == 0);
+        static_assert(sanisizer::product_min<std::int8_t, sanisizer::Attestation<i32, 1000, 200>, Bounded>() == 127);
+    }
+}
+
 TEST(Product, Unsafe) {
     EXPECT_EQ(sanisizer::product_unsafe<std::uint8_t>((i32)5, (i32)20), 100);
     EXPECT_EQ(sanisizer::product_unsafe<std::uint8_t>((u32)5, (i32)20), 100);
@@ -184,3 +378,330 @@ TEST(Product, Unsafe) {
     // Works at compile-time.
     static_assert(sanisizer::product_unsafe<std::int64_t>((i32)5, (i32)20) == 100);
 }
+
+TEST(Product, Try) {
+    static_assert(noexcept(sanisizer::try_product<std::uint8_t>(1, 2)));
+
+    EXPECT_EQ(*sanisizer::try_product<std::uint8_t>((u32)5, (i32)20), 100);
+    EXPECT_EQ(*sanisizer::try_product<std::uint8_t>((u32)5, (u32)17, (u32)3), 255);
+    EXPECT_EQ(*sanisizer::try_product<std::int64_t>((i32)5, (u32)20), 100);
+    EXPECT_EQ(*sanisizer::try_product<std::int8_t>(5, sanisizer::Attestation<i32, 100>((i32)20)), 100);
+
+    EXPECT_FALSE(sanisizer::try_product<std::uint8_t>((u32)5, (u32)20, (u32)3).has_value());
+    EXPECT_FALSE(sanisizer::try_product<std::uint8_t>((u32)256, (u32)0).has_value());
+    EXPECT_FALSE(sanisizer::try_product<std::uint8_t>((u32)0, (u32)256).has_value());
+    EXPECT_FALSE(sanisizer::try_product<std::int8_t>(10, sanisizer::Attestation<i32, 1000>((i32)13)).has_value());
+
+    // Works at compile-time.
+    static_assert(*sanisizer::try_product<std::int64_t>((i32)5, (i32)20) == 100);
+    static_assert(!sanisizer::try_product<std::uint8_t>(20, 20).has_value());
+}
+
+TEST(Product, Range) {
+    std::vector<std::size_t> dims{ 5, 10, 20 };
+    auto prod = sanisizer::product_range<std::int64_t>(dims.begin(), dims.end());
+    static_assert(std::is_same<decltype(prod), std::int64_t>::value);
+    EXPECT_EQ(prod, 1000);
+    EXPECT_EQ(sanisizer::product_range<std::int64_t>(dims.begin(), dims.begin()), 1);
+
+    dims.push_back(10);
+    EXPECT_EQ(sanisizer::product_range<std::uint16_t>(dims.begin(), dims.end()), 10000);
+    {
+        bool failed = false;
+        try {
+            sanisizer::product_range<std::uint8_t>(dims.begin(), dims.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Short-circuits on zero, but still checks the individual values.
+    std::vector<i32> with_zero{ 100, 0, 100, 100 };
+    EXPECT_EQ(sanisizer::product_range<std::uint8_t>(with_zero.begin(), with_zero.end()), 0);
+    with_zero.push_back(1000);
+    {
+        bool failed = false;
+        try {
+            sanisizer::product_range<std::uint8_t>(with_zero.begin(), with_zero.end());
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Works with attestations.
+    std::vector<sanisizer::Attestation<u32, 10> > attested{ 2, 5, 10 };
+    EXPECT_EQ(sanisizer::product_range<std::uint8_t>(attested.begin(), attested.end()), 100);
+
+    // Works at compile-time.
+    constexpr std::array<int, 3> cdims{ 2, 3, 4 };
+    static_assert(sanisizer::product_range<int>(cdims.begin(), cdims.end()) == 24);
+}
+
+TEST(Difference, Basic) {
+    {
+        static_assert(sanisizer::needs_difference_check<u32, u32>());
+        static_assert(sanisizer::needs_difference_check<sanisizer::Attestation<u32, 100, 10>, sanisizer::Attestation<u32, 20> >());
+        static_assert(!sanisizer::needs_difference_check<sanisizer::Attestation<u32, 100, 20>, sanisizer::Attestation<u32, 20> >());
+        static_assert(sanisizer::needs_difference_check<sanisizer::Attestation<i32, 100, 50>, std::uint8_t>());
+        static_assert(!sanisizer::needs_difference_check<u32, sanisizer::Attestation<i32, 0> >());
+    }
+
+    {
+        EXPECT_EQ(sanisizer::difference<std::int64_t>((i32)25, (i32)5), 20);
+        EXPECT_EQ(sanisizer::difference<std::int64_t>((u32)25, (i32)5), 20);
+        EXPECT_EQ(sanisizer::difference<std::uint8_t>((i32)25, (u32)25), 0);
+        EXPECT_EQ(sanisizer::difference<std::uint8_t>((u32)1000, (u32)800), 200);
+        EXPECT_EQ(sanisizer::difference<std::int8_t>(sanisizer::Attestation<i32, 1000, 100>(200), (std::uint8_t)100), 100);
+
+        // Works at compile time.
+        static_assert(sanisizer::difference<int>(50, 20) == 30);
+
+        // Returns a plain integer like sum() and product(), even for attested inputs.
+        static_assert(std::is_same<decltype(sanisizer::difference<std::uint8_t>(sanisizer::Attestation<i32, 1000, 300>(300), (u32)100)), std::uint8_t>::value);
+    }
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::difference<std::int64_t>((u32)5, (u32)6);
+        } catch (std::out_of_range& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::difference<std::uint8_t>((u32)1000, (u32)100);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
+
+TEST(Difference, Bounds) {
+    {
+        constexpr auto out = sanisizer::difference_protected<std::uint64_t>(sanisizer::Attestation<u32, 100, 50>(80), sanisizer::Attestation<u32, 20, 10>(15));
+        static_assert(out.value == 65);
+        static_assert(decltype(out)::max == 90);
+        static_assert(decltype(out)::min == 30);
+    }
+
+    {
+        // Maximum is that of the first argument if nothing is known about the second.
+        constexpr auto out = sanisizer::difference_protected<std::uint64_t>((u32)100, (std::uint8_t)20);
+        static_assert(decltype(out)::max == std::numeric_limits<u32>::max());
+        static_assert(decltype(out)::min == 0);
+
+        // Result can be cast without any further checks.
+        static_assert(!sanisizer::needs_sum_check<std::uint64_t, std::remove_const_t<decltype(out)>, u32>());
+    }
+
+    {
+        // Bounds are capped to the destination type.
+        constexpr auto out = sanisizer::difference_protected<std::uint8_t>(sanisizer::Attestation<u32, 1000, 300>(300), (std::uint8_t)100);
+        static_assert(out.value == 200);
+        static_assert(decltype(out)::max == 255);
+        static_assert(decltype(out)::min == 45);
+    }
+}
+
+TEST(Difference, Try) {
+    static_assert(noexcept(sanisizer::try_difference<std::uint8_t>(2, 1)));
+
+    EXPECT_EQ(*sanisizer::try_difference<std::uint8_t>((u32)25, (i32)5), 20);
+    EXPECT_EQ(*sanisizer::try_difference<std::int8_t>(sanisizer::Attestation<i32, 1000, 100>(200), (std::uint8_t)100), 100);
+    EXPECT_FALSE(sanisizer::try_difference<std::uint8_t>((u32)5, (u32)6).has_value());
+    EXPECT_FALSE(sanisizer::try_difference<std::uint8_t>((u32)1000, (u32)100).has_value());
+    EXPECT_FALSE(sanisizer::try_difference<std::int8_t>((u32)5, (u32)200).has_value());
+
+    static_assert(*sanisizer::try_difference<int>(50, 20) == 30);
+    static_assert(!sanisizer::try_difference<int>(20, 50).has_value());
+}
+
+TEST(Divide, Basic) {
+    EXPECT_EQ(sanisizer::divide<std::int64_t>((i32)25, (i32)5).value, 5);
+    EXPECT_EQ(sanisizer::divide<std::int64_t>((u32)26, (i32)5).value, 5);
+    EXPECT_EQ(sanisizer::divide<std::uint8_t>((i32)29, (u32)5).value, 5);
+    EXPECT_EQ(sanisizer::divide<std::uint8_t>((u32)1000, (u32)4).value, 250);
+    EXPECT_EQ(sanisizer::divide<std::uint8_t>((u32)0, (u32)4).value, 0);
+
+    EXPECT_EQ(sanisizer::ceil_divide<std::int64_t>((i32)25, (i32)5).value, 5);
+    EXPECT_EQ(sanisizer::ceil_divide<std::int64_t>((u32)26, (i32)5).value, 6);
+    EXPECT_EQ(sanisizer::ceil_divide<std::uint8_t>((i32)29, (u32)5).value, 6);
+    EXPECT_EQ(sanisizer::ceil_divide<std::uint8_t>((u32)0, (u32)5).value, 0);
+
+    // Does not overflow near the maximum.
+    constexpr auto u64max = std::numeric_limits<std::uint64_t>::max();
+    EXPECT_EQ(sanisizer::ceil_divide<std::uint64_t>(u64max, (u32)2).value, u64max / 2 + 1);
+    EXPECT_EQ(sanisizer::ceil_divide<std::uint64_t>(u64max, u64max).value, 1);
+    EXPECT_EQ(sanisizer::ceil_divide<std::uint8_t>((std::uint8_t)255, (std::uint8_t)16).value, 16);
+
+    // Works at compile time.
+    static_assert(sanisizer::divide<int>(50, 20).value == 2);
+    static_assert(sanisizer::ceil_divide<int>(50, 20).value == 3);
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::divide<std::int64_t>((u32)5, (u32)0);
+        } catch (std::domain_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::ceil_divide<std::uint8_t>((u32)1000, (u32)3);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
+
+TEST(Divide, Bounds) {
+    static_assert(sanisizer::needs_divisor_check<u32>());
+    static_assert(sanisizer::needs_divisor_check<sanisizer::Attestation<u32, 100> >());
+    static_assert(!sanisizer::needs_divisor_check<sanisizer::Attestation<u32, 100, 1> >());
+
+    {
+        constexpr auto out = sanisizer::divide<std::uint8_t>(sanisizer::Attestation<u32, 10000, 1000>(5000), sanisizer::Attestation<u32, 100, 50>(60));
+        static_assert(out.value == 83);
+        static_assert(decltype(out)::max == 200);
+        static_assert(decltype(out)::min == 10);
+    }
+
+    {
+        // Block count can be cast to a narrow type without further checks.
+        constexpr auto out = sanisizer::ceil_divide<std::uint64_t>(sanisizer::Attestation<u32, 1000000>(999999), sanisizer::Attestation<u32, 100000, 10000>(10000));
+        static_assert(out.value == 100);
+        static_assert(decltype(out)::max == 100);
+        static_assert(decltype(out)::min == 0);
+        static_assert(sanisizer::cast<std::int8_t>(out) == 100);
+    }
+
+    {
+        // Maximum is that of the numerator if nothing is known about the divisor.
+        constexpr auto out = sanisizer::divide<std::uint64_t>((std::uint8_t)100, (u32)7);
+        static_assert(decltype(out)::max == 255);
+        constexpr auto out2 = sanisizer::ceil_divide<std::uint64_t>((std::uint8_t)100, (u32)7);
+        static_assert(decltype(out2)::max == 255);
+    }
+}
+
+TEST(Modulo, Basic) {
+    EXPECT_EQ(sanisizer::modulo<std::int64_t>((i32)25, (i32)5).value, 0);
+    EXPECT_EQ(sanisizer::modulo<std::int64_t>((u32)26, (i32)5).value, 1);
+    EXPECT_EQ(sanisizer::modulo<std::uint8_t>((u32)1000, (u32)300).value, 100);
+    static_assert(sanisizer::modulo<int>(50, 20).value == 10);
+
+    {
+        constexpr auto out = sanisizer::modulo<std::uint8_t>((u32)1000, sanisizer::Attestation<u32, 100, 1>(30));
+        static_assert(out.value == 10);
+        static_assert(decltype(out)::max == 99);
+        constexpr auto out2 = sanisizer::modulo<std::uint64_t>((std::uint8_t)100, (u32)7);
+        static_assert(decltype(out2)::max == 255);
+    }
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::modulo<std::int64_t>((u32)5, (u32)0);
+        } catch (std::domain_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    {
+        bool failed = false;
+        try {
+            sanisizer::modulo<std::uint8_t>((u32)999, (u32)500);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
+
+TEST(AlignUp, Basic) {
+    EXPECT_EQ(sanisizer::align_up<std::int64_t>((i32)25, (i32)5).value, 25);
+    EXPECT_EQ(sanisizer::align_up<std::int64_t>((u32)26, (i32)5).value, 30);
+    EXPECT_EQ(sanisizer::align_up<std::uint8_t>((i32)0, (u32)5).value, 0);
+    EXPECT_EQ(sanisizer::align_up<std::uint8_t>((i32)250, (u32)5).value, 250);
+    EXPECT_EQ(sanisizer::align_up<std::uint8_t>((i32)240, (u32)16).value, 240);
+    EXPECT_EQ(sanisizer::align_up<std::uint8_t>((i32)1, (u32)255).value, 255);
+
+    EXPECT_EQ((sanisizer::align_up<std::int64_t, 64>((i32)0).value), 0);
+    EXPECT_EQ((sanisizer::align_up<std::int64_t, 64>((i32)1).value), 64);
+    EXPECT_EQ((sanisizer::align_up<std::int64_t, 64>((i32)64).value), 64);
+    EXPECT_EQ((sanisizer::align_up<std::int64_t, 64>((i32)65).value), 128);
+    EXPECT_EQ((sanisizer::align_up<std::uint8_t, 3>((i32)250).value), 252);
+    EXPECT_EQ((sanisizer::align_up<std::uint8_t, 16>((i32)240).value), 240);
+
+    // Works at compile time.
+    static_assert(sanisizer::align_up<int>(50, 20).value == 60);
+    static_assert(sanisizer::align_up<int, 32>(50).value == 64);
+
+    // Does not wrap around near the maximum.
+    constexpr auto u64max = std::numeric_limits<std::uint64_t>::max();
+    EXPECT_EQ((sanisizer::align_up<std::uint64_t, 1>(u64max).value), u64max);
+    EXPECT_EQ((sanisizer::align_up<std::uint64_t>(u64max - 100, (u32)2).value), u64max - 99);
+
+    auto expect_overflow = [](auto fun) {
+        bool failed = false;
+        try {
+            fun();
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    };
+    expect_overflow([&]() { sanisizer::align_up<std::uint64_t>(u64max, (u32)2); });
+    expect_overflow([&]() { sanisizer::align_up<std::uint64_t, 4096>(u64max - 100); });
+    expect_overflow([&]() { sanisizer::align_up<std::uint8_t>((u32)250, (u32)16); });
+    expect_overflow([&]() { sanisizer::align_up<std::uint8_t, 16>((u32)250); });
+    expect_overflow([&]() { sanisizer::align_up<std::uint8_t>((u32)256, (u32)1); });
+    expect_overflow([&]() { sanisizer::align_up<std::uint8_t>((u32)1, (u32)256); });
+
+    bool failed = false;
+    try {
+        sanisizer::align_up<std::int64_t>((u32)5, (u32)0);
+    } catch (std::domain_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+TEST(AlignUp, Bounds) {
+    {
+        constexpr auto out = sanisizer::align_up<std::uint16_t, 64>(sanisizer::Attestation<u32, 1000, 10>(100));
+        static_assert(out.value == 128);
+        static_assert(decltype(out)::max == 1024);
+        static_assert(decltype(out)::min == 64);
+        static_assert(!sanisizer::needs_product_check<std::uint32_t, std::remove_const_t<decltype(out)>, std::uint16_t>());
+    }
+
+    {
+        constexpr auto out = sanisizer::align_up<std::uint16_t>(sanisizer::Attestation<u32, 1000, 10>(100), sanisizer::Attestation<u32, 64, 1>(64));
+        static_assert(out.value == 128);
+        static_assert(decltype(out)::max == 1063);
+        static_assert(decltype(out)::min == 10);
+    }
+
+    {
+        // Capped at the largest multiple that can be represented.
+        constexpr auto out = sanisizer::align_up<std::uint8_t, 16>((u32)10);
+        static_assert(out.value == 16);
+        static_assert(decltype(out)::max == 240);
+        constexpr auto out2 = sanisizer::align_up<std::uint8_t>((u32)10, (u32)16);
+        static_assert(decltype(out2)::max == 255);
+    }
+}
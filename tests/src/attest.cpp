@@ -106,6 +106,52 @@ TEST(Attest, Limit) {
     }
 }
 
+TEST(Attest, Minimum) {
+    {
+        constexpr sanisizer::Attestation<int, 20, 5> val(10);
+        static_assert(decltype(val)::min == 5);
+        static_assert(decltype(val)::max == 20);
+        static_assert(sanisizer::get_min<sanisizer::Attestation<int, 20, 5> >() == 5);
+        static_assert(sanisizer::is_Attestation<sanisizer::Attestation<int, 20, 5> >::value);
+
+        static_assert(sanisizer::get_min<sanisizer::Attestation<int, 20> >() == 0);
+        static_assert(sanisizer::get_min<int>() == 0);
+        static_assert(std::is_same<decltype(sanisizer::get_min<std::uint8_t>()), std::uint8_t>::value);
+    }
+
+    {
+        constexpr auto thing = sanisizer::attest_min<int, 1>(20u);
+        static_assert(std::is_same<typename decltype(thing)::Integer, unsigned>::value);
+        static_assert(thing.value == 20);
+        static_assert(decltype(thing)::min == 1);
+        static_assert(decltype(thing)::max == std::numeric_limits<unsigned>::max());
+    }
+
+    {
+        // No-op if the minimum is already known.
+        constexpr auto thing = sanisizer::attest_min<int, 0>(20);
+        static_assert(std::is_same<decltype(thing), const int>::value);
+        constexpr auto thing2 = sanisizer::attest_min<int, 2>(sanisizer::Attestation<int, 20, 5>(10));
+        static_assert(decltype(thing2)::min == 5);
+    }
+
+    {
+        // Preserves the existing maximum, and vice versa.
+        constexpr auto thing = sanisizer::attest_min<int, 2>(sanisizer::Attestation<int, 20>(10));
+        static_assert(decltype(thing)::min == 2);
+        static_assert(decltype(thing)::max == 20);
+        constexpr auto thing2 = sanisizer::attest_max<int, 10>(thing);
+        static_assert(decltype(thing2)::min == 2);
+        static_assert(decltype(thing2)::max == 10);
+    }
+
+    { // also works at run-time.
+        auto val = sanisizer::attest_min<int, 1>(5);
+        EXPECT_EQ(sanisizer::get_min<decltype(val)>(), 1);
+        EXPECT_EQ(sanisizer::get_value(val), 5);
+    }
+}
+
 TEST(Attest, CheckOverflow) {
     {
         static_assert(!sanisizer::check_overflow<int>(10));
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/budget.hpp"
+#include "sanisizer/create.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TEST(MemoryBudget, Basic) {
+    sanisizer::MemoryBudget budget(100);
+    EXPECT_EQ(budget.limit(), 100);
+    EXPECT_EQ(budget.used(), 0);
+
+    EXPECT_TRUE(budget.try_charge(60));
+    EXPECT_EQ(budget.used(), 60);
+    EXPECT_EQ(budget.available(), 40);
+    EXPECT_FALSE(budget.try_charge(41));
+    EXPECT_EQ(budget.used(), 60);
+
+    budget.charge(40);
+    EXPECT_EQ(budget.available(), 0);
+    budget.refund(70);
+    EXPECT_EQ(budget.used(), 30);
+    EXPECT_EQ(budget.high_water(), 100);
+
+    budget.reset_high_water();
+    EXPECT_EQ(budget.high_water(), 30);
+
+    bool failed = false;
+    try {
+        budget.charge(71);
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Charges that would overflow are refused.
+    sanisizer::MemoryBudget unlimited(std::numeric_limits<std::size_t>::max());
+    EXPECT_TRUE(unlimited.try_charge(10));
+    EXPECT_FALSE(unlimited.try_charge(std::numeric_limits<std::size_t>::max()));
+    EXPECT_EQ(unlimited.used(), 10);
+}
+
+TEST(MemoryBudget, Threads) {
+    sanisizer::MemoryBudget budget(1000);
+    std::vector<std::thread> workers;
+    std::vector<int> successes(4);
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&](int t) -> void {
+            for (int i = 0; i < 1000; ++i) {
+                successes[t] += budget.try_charge(1);
+            }
+        }, t);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    EXPECT_EQ(successes[0] + successes[1] + successes[2] + successes[3], 1000);
+    EXPECT_EQ(budget.used(), 1000);
+    EXPECT_EQ(budget.high_water(), 1000);
+}
+
+TEST(BudgetAllocator, Basic) {
+    sanisizer::MemoryBudget budget(4000);
+    typedef std::vector<int, sanisizer::BudgetAllocator<int> > BudgetVector;
+    sanisizer::BudgetAllocator<int> alloc(budget);
+    EXPECT_EQ(alloc.max_size(), std::allocator_traits<std::allocator<int> >::max_size(std::allocator<int>()));
+
+    {
+        auto vec = sanisizer::create<BudgetVector>(100, alloc);
+        EXPECT_EQ(vec.size(), 100);
+        EXPECT_EQ(budget.used(), 100 * sizeof(int));
+
+        // Fails in the allocator.
+        bool failed = false;
+        try {
+            sanisizer::resize(vec, 1000); // 100 ints already charged, so 1000 more will not fit.
+        } catch (std::bad_alloc& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+        EXPECT_EQ(vec.size(), 100);
+        EXPECT_EQ(budget.used(), 100 * sizeof(int));
+
+        sanisizer::reserve(vec, 200);
+        EXPECT_EQ(budget.used(), 200 * sizeof(int));
+        EXPECT_EQ(budget.high_water(), 300 * sizeof(int));
+    }
+
+    // Refunded upon destruction.
+    EXPECT_EQ(budget.used(), 0);
+
+    // Rebinding works and compares equal.
+    sanisizer::BudgetAllocator<double> dalloc(alloc);
+    EXPECT_TRUE(dalloc == alloc);
+    sanisizer::MemoryBudget other(10);
+    EXPECT_TRUE(sanisizer::BudgetAllocator<int>(other) != alloc);
+}
+
+TEST(BudgetAllocator, PushBack) {
+    sanisizer::MemoryBudget budget(1000);
+    std::vector<int, sanisizer::BudgetAllocator<int> > vec{ sanisizer::BudgetAllocator<int>(budget) };
+
+    bool failed = false;
+    try {
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back(i);
+        }
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_LE(budget.used(), 1000);
+    EXPECT_EQ(budget.used(), vec.capacity() * sizeof(int));
+    for (int i = 0, end = vec.size(); i < end; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+}
+
+TEST(BudgetAllocator, Propagation) {
+    typedef std::vector<int, sanisizer::BudgetAllocator<int> > BudgetVector;
+    static_assert(!std::allocator_traits<sanisizer::BudgetAllocator<int> >::is_always_equal::value);
+
+    sanisizer::MemoryBudget budget1(1000), budget2(1000);
+    {
+        BudgetVector vec1(10, 0, sanisizer::BudgetAllocator<int>(budget1));
+        BudgetVector vec2(20, 0, sanisizer::BudgetAllocator<int>(budget2));
+        EXPECT_EQ(budget1.used(), 10 * sizeof(int));
+        EXPECT_EQ(budget2.used(), 20 * sizeof(int));
+
+        // Swapping carries the allocators along with the memory.
+        std::swap(vec1, vec2);
+        EXPECT_EQ(vec1.get_allocator().budget(), &budget2);
+        EXPECT_EQ(vec2.get_allocator().budget(), &budget1);
+        EXPECT_EQ(budget1.used(), 10 * sizeof(int));
+        EXPECT_EQ(budget2.used(), 20 * sizeof(int));
+
+        // Move assignment also carries the allocator.
+        BudgetVector vec3(5, 0, sanisizer::BudgetAllocator<int>(budget1));
+        EXPECT_EQ(budget1.used(), 15 * sizeof(int));
+        vec3 = std::move(vec1);
+        EXPECT_EQ(vec3.get_allocator().budget(), &budget2);
+        EXPECT_EQ(budget1.used(), 10 * sizeof(int));
+        EXPECT_EQ(budget2.used(), 20 * sizeof(int));
+
+        // Copy assignment keeps the destination's budget.
+        BudgetVector vec4(sanisizer::BudgetAllocator<int>{budget1});
+        vec4 = vec3;
+        EXPECT_EQ(vec4.get_allocator().budget(), &budget1);
+        EXPECT_EQ(budget1.used(), 30 * sizeof(int));
+        EXPECT_EQ(budget2.used(), 20 * sizeof(int));
+    }
+
+    EXPECT_EQ(budget1.used(), 0);
+    EXPECT_EQ(budget2.used(), 0);
+}
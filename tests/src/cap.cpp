@@ -24,6 +24,27 @@ TEST(Cap, Basic) {
     EXPECT_TRUE(okay);
 }
 
+TEST(Cap, Attested) {
+    // Bounds of attestations are propagated.
+    constexpr auto capped = sanisizer::cap_attested<std::uint8_t>(sanisizer::Attestation<int, 10000, 10>(1000));
+    static_assert(capped.value == 255);
+    static_assert(decltype(capped)::max == 255);
+    static_assert(decltype(capped)::min == 10);
+
+    constexpr auto capped2 = sanisizer::cap_attested<std::uint64_t>(sanisizer::Attestation<int, 100>(50));
+    static_assert(capped2.value == 50);
+    static_assert(decltype(capped2)::max == 100);
+
+    // Plain inputs are bounded by the maximum of the destination.
+    constexpr auto capped3 = sanisizer::cap_attested<std::uint8_t>(1000);
+    static_assert(capped3.value == 255);
+    static_assert(decltype(capped3)::max == 255);
+
+    // The regular function still returns a plain integer.
+    static_assert(std::is_same<decltype(sanisizer::cap<std::uint64_t>(sanisizer::Attestation<int, 100>(50))), std::uint64_t>::value);
+    static_assert(std::is_same<decltype(sanisizer::get_value(capped2)), std::uint64_t>::value);
+}
+
 // Check it works as constexpr defaults.
 struct FooBarOptions {
     std::int8_t thing8 = sanisizer::cap<std::int8_t>(10000);
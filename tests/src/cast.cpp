@@ -41,3 +41,46 @@ TEST(Cast, Basic) {
     }
     EXPECT_TRUE(failed);
 }
+
+TEST(Cast, Attested) {
+    constexpr auto out = sanisizer::cast_attested<std::uint64_t>(sanisizer::Attestation<int, 100, 10>(50));
+    static_assert(out.value == 50);
+    static_assert(decltype(out)::max == 100);
+    static_assert(decltype(out)::min == 10);
+
+    // Capped at the destination's maximum.
+    constexpr auto out2 = sanisizer::cast_attested<std::uint8_t>(sanisizer::Attestation<int, 1000>(50));
+    static_assert(decltype(out2)::max == 255);
+
+    // Conversion to a plain integer must be explicit.
+    static_assert(!std::is_convertible<decltype(out), std::uint64_t>::value);
+    std::uint64_t raw = static_cast<std::uint64_t>(sanisizer::cast_attested<std::uint64_t>(sanisizer::Attestation<int, 100>(10)));
+    EXPECT_EQ(raw, 10);
+    static_assert(std::is_same<decltype(sanisizer::get_value(out)), std::uint64_t>::value);
+
+    // Throws like the regular cast.
+    bool failed = false;
+    try {
+        sanisizer::cast_attested<std::uint8_t>(sanisizer::Attestation<int, 1000>(256));
+    } catch (std::exception& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // The regular function still returns a plain integer.
+    static_assert(std::is_same<decltype(sanisizer::cast<std::uint64_t>(sanisizer::Attestation<int, 100>(10))), std::uint64_t>::value);
+}
+
+TEST(Cast, Try) {
+    static_assert(noexcept(sanisizer::try_cast<std::uint8_t>(1)));
+
+    EXPECT_EQ(*sanisizer::try_cast<std::int32_t>((u32)1), 1);
+    EXPECT_EQ(*sanisizer::try_cast<std::uint8_t>((u32)255), 255);
+    EXPECT_EQ(*sanisizer::try_cast<std::uint8_t>(sanisizer::Attestation<int, 100>(10)), 10);
+    EXPECT_FALSE(sanisizer::try_cast<std::uint8_t>(256).has_value());
+    EXPECT_FALSE(sanisizer::try_cast<std::int8_t>((u8)128).has_value());
+
+    // Works at compile time.
+    static_assert(*sanisizer::try_cast<std::uint8_t>(10) == 10);
+    static_assert(!sanisizer::try_cast<std::uint8_t>(1000).has_value());
+}
@@ -127,6 +127,38 @@ TEST(Comparisons, Min) {
     static_assert(std::is_same<decltype(attest_check2), const std::int8_t>::value);
 }
 
+TEST(Comparisons, MinAttested) {
+    // Bounds are propagated from the attestations.
+    constexpr auto bounded = sanisizer::min_attested(std::size_t(10000), sanisizer::Attestation<std::size_t, 4096>(100));
+    static_assert(bounded.value == 100);
+    static_assert(decltype(bounded)::max == 4096);
+    static_assert(decltype(bounded)::min == 0);
+
+    constexpr auto bounded2 = sanisizer::min_attested(sanisizer::Attestation<int, 1000, 50>(60), sanisizer::Attestation<unsigned, 100, 20>(70u));
+    static_assert(bounded2.value == 60);
+    static_assert(std::is_same<typename decltype(bounded2)::Integer, unsigned>::value);
+    static_assert(decltype(bounded2)::max == 100);
+    static_assert(decltype(bounded2)::min == 20);
+
+    // Plain inputs are bounded by their types.
+    auto plain = sanisizer::min_attested(std::uint8_t(10), 5);
+    static_assert(std::is_same<decltype(plain), sanisizer::Attestation<std::uint8_t, 255> >::value);
+    EXPECT_EQ(plain.value, 5);
+}
+
+TEST(Comparisons, MaxAttested) {
+    constexpr auto bounded = sanisizer::max_attested(sanisizer::Attestation<int, 1000, 50>(60), sanisizer::Attestation<unsigned, 100, 20>(70u));
+    static_assert(bounded.value == 70);
+    static_assert(std::is_same<typename decltype(bounded)::Integer, int>::value);
+    static_assert(decltype(bounded)::max == 1000);
+    static_assert(decltype(bounded)::min == 50);
+
+    constexpr auto bounded2 = sanisizer::max_attested(std::uint8_t(10), sanisizer::Attestation<int, 1000, 50>(60));
+    static_assert(bounded2.value == 60);
+    static_assert(decltype(bounded2)::max == 1000);
+    static_assert(decltype(bounded2)::min == 50);
+}
+
 TEST(Comparisons, Max) {
     auto x = sanisizer::max(static_cast<std::uint8_t>(255), 100);
     static_assert(std::is_same<decltype(x), int>::value);
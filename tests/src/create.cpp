@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 
 #include "sanisizer/create.hpp"
+#include "sanisizer/overwrite.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
+#include <limits>
 
 TEST(Create, Basic) {
     auto output = sanisizer::create<std::vector<int> >(20);
@@ -82,3 +87,147 @@ TEST(Reserve, Basic) {
     }
     EXPECT_TRUE(failed);
 }
+
+struct MockRow {
+    typedef int value_type;
+    MockRow() = default;
+    MockRow(std::uint8_t s) : my_size(s) {}
+    std::uint8_t my_size = 0;
+    std::uint8_t size() const { return my_size; }
+};
+
+TEST(CreateNested, Basic) {
+    auto output = sanisizer::create_nested<std::vector<std::vector<int> > >(5, 3);
+    EXPECT_EQ(output.size(), 5);
+    for (const auto& row : output) {
+        EXPECT_EQ(row, std::vector<int>(3));
+    }
+
+    auto filled = sanisizer::create_nested<std::vector<std::vector<int> > >(sanisizer::Attestation<int, 10>(4), 2, 7);
+    EXPECT_EQ(filled.size(), 4);
+    for (const auto& row : filled) {
+        EXPECT_EQ(row, std::vector<int>(2, 7));
+    }
+
+    auto mock = sanisizer::create_nested<std::vector<MockRow> >(3, 200);
+    EXPECT_EQ(mock.size(), 3);
+    EXPECT_EQ(mock.front().size(), 200);
+
+    auto empty = sanisizer::create_nested<std::vector<std::vector<int> > >(0, 10);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(CreateNested, Overflow) {
+    // Inner size is checked.
+    {
+        bool failed = false;
+        try {
+            sanisizer::create_nested<std::vector<MockRow> >(3, 300);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Total number of bytes is checked before any allocation.
+    {
+        bool failed = false;
+        try {
+            sanisizer::create_nested<std::vector<std::vector<std::uint64_t> > >(std::numeric_limits<std::size_t>::max() / 4, 4);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
+
+TEST(CreateFlat, Basic) {
+    auto output = sanisizer::create_flat<std::vector<int> >(4, 5, 1);
+    EXPECT_EQ(output, std::vector<int>(20, 1));
+
+    bool failed = false;
+    try {
+        sanisizer::create_flat<std::vector<std::uint32_t> >(std::numeric_limits<std::size_t>::max() / 2, 2);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+template<typename Type_>
+struct SmallAllocator : public std::allocator<Type_> {
+    SmallAllocator() = default;
+    template<typename Other_>
+    SmallAllocator(const SmallAllocator<Other_>&) {}
+    template<typename Other_>
+    struct rebind {
+        typedef SmallAllocator<Other_> other;
+    };
+    std::size_t max_size() const { return 100; }
+};
+
+TEST(Create, AllocationSize) {
+    static_assert(!sanisizer::needs_allocation_check<std::vector<int>, std::uint8_t>());
+    static_assert(!sanisizer::needs_allocation_check<std::vector<int>, sanisizer::Attestation<std::size_t, 1000> >());
+    static_assert(sanisizer::needs_allocation_check<std::vector<int>, std::size_t>());
+    static_assert(!sanisizer::needs_allocation_check<MockVector, std::size_t>());
+    static_assert(!sanisizer::needs_allocation_check<MockRow, std::size_t>()); // size type is too small to cause problems.
+    static_assert(sanisizer::needs_allocation_check<std::vector<int, SmallAllocator<int> >, std::uint8_t>());
+
+    auto expect_overflow = [](auto fun) -> void {
+        bool failed = false;
+        try {
+            fun();
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    };
+
+    // Fails before reaching the allocator.
+    const std::size_t huge = std::numeric_limits<std::size_t>::max() / 4;
+    expect_overflow([&]() -> void { sanisizer::create<std::vector<double> >(huge); });
+    std::vector<double> existing;
+    expect_overflow([&]() -> void { sanisizer::resize(existing, huge); });
+    expect_overflow([&]() -> void { sanisizer::reserve(existing, huge); });
+
+    // Respects the allocator's maximum.
+    typedef std::vector<int, SmallAllocator<int> > SmallVector;
+    auto small = sanisizer::create<SmallVector>(100);
+    EXPECT_EQ(small.size(), 100);
+    expect_overflow([&]() -> void { sanisizer::create<SmallVector>(101); });
+    expect_overflow([&]() -> void { sanisizer::resize(small, 101); });
+    expect_overflow([&]() -> void { sanisizer::reserve(small, 101); });
+    sanisizer::resize(small, 50);
+    EXPECT_EQ(small.size(), 50);
+}
+
+TEST(Create, ByteLimit) {
+    // All creation functions share the same byte limit, so they all fail just above it.
+    const std::size_t limit = static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max()) / sizeof(double);
+    EXPECT_EQ(sanisizer::max_elements_of_type<double>(), limit);
+    EXPECT_EQ(sanisizer::max_elements_by_bytes<std::vector<double> >(), limit);
+
+    auto expect_byte_overflow = [](auto fun) -> void {
+        std::string msg;
+        try {
+            fun();
+        } catch (std::overflow_error& e) {
+            msg = e.what();
+        }
+        EXPECT_TRUE(msg.find("number of bytes exceeds the maximum allocation size") != std::string::npos) << msg;
+    };
+
+    const std::size_t above = limit + 1;
+    expect_byte_overflow([&]() -> void { sanisizer::create<std::vector<double> >(above); });
+    std::vector<double> existing;
+    expect_byte_overflow([&]() -> void { sanisizer::resize(existing, above); });
+    expect_byte_overflow([&]() -> void { sanisizer::reserve(existing, above); });
+    expect_byte_overflow([&]() -> void { sanisizer::create_unique_for_overwrite<double>(above); });
+    expect_byte_overflow([&]() -> void { sanisizer::create_vector_for_overwrite<double>(above); });
+
+    // Same for the total size of nested and flattened containers, even though the number of bytes is well below the maximum of std::size_t.
+    const std::size_t half = limit / 2 + 1;
+    expect_byte_overflow([&]() -> void { sanisizer::create_nested<std::vector<std::vector<double> > >(2, half); });
+    expect_byte_overflow([&]() -> void { sanisizer::create_flat<std::vector<double> >(2, half); });
+}
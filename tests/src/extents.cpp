@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/extents.hpp"
+#include "sanisizer/nd_offset.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+TEST(Extents, Static) {
+    constexpr sanisizer::Extents<int, 3, 4, 5> ext;
+    static_assert(ext.rank() == 3);
+    static_assert(ext.rank_dynamic() == 0);
+    static_assert(ext.size() == 60);
+    static_assert(ext.stride<2>() == 12);
+    static_assert(ext.offset(2, 3, 4) == 59);
+
+    EXPECT_EQ(ext.extent(1), 4);
+    EXPECT_EQ(ext.stride(1), 3);
+    EXPECT_EQ(ext.static_extent(2), 5u);
+
+    auto attested = ext.extent<1>();
+    static_assert(sanisizer::is_Attestation<decltype(attested)>::value);
+    static_assert(decltype(attested)::max == 4);
+    EXPECT_EQ(attested.value, 4);
+}
+
+TEST(Extents, Mixed) {
+    sanisizer::Extents<std::size_t, 3, sanisizer::dynamic_extent, 4, sanisizer::dynamic_extent> ext(10, 20);
+    EXPECT_EQ(ext.rank(), 4u);
+    EXPECT_EQ(ext.rank_dynamic(), 2u);
+    EXPECT_EQ(ext.size(), 3u * 10u * 4u * 20u);
+    EXPECT_EQ(ext.static_extent(1), sanisizer::dynamic_extent);
+
+    std::array<std::size_t, 4> expected_extents{ 3, 10, 4, 20 };
+    EXPECT_EQ(ext.extents(), expected_extents);
+    EXPECT_EQ(ext.extent(1), 10u);
+    EXPECT_EQ(ext.extent(2), 4u);
+    static_assert(std::is_same<decltype(ext.extent<1>()), std::size_t>::value);
+
+    EXPECT_EQ(ext.stride(0), 1u);
+    EXPECT_EQ(ext.stride(1), 3u);
+    EXPECT_EQ(ext.stride(2), 30u);
+    EXPECT_EQ(ext.stride(3), 120u);
+    EXPECT_EQ(ext.stride<1>(), 3u);
+    EXPECT_EQ(ext.stride<3>(), 120u);
+
+    for (std::size_t l = 0; l < 20; l += 3) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            for (std::size_t j = 0; j < 10; j += 2) {
+                for (std::size_t i = 0; i < 3; ++i) {
+                    EXPECT_EQ(ext.offset(i, j, k, l), sanisizer::nd_offset<std::size_t>(i, 3, j, 10, k, 4, l));
+                }
+            }
+        }
+    }
+
+    // Works at compile time.
+    constexpr sanisizer::Extents<int, sanisizer::dynamic_extent, 5> cext(7);
+    static_assert(cext.size() == 35);
+    static_assert(cext.offset(6, 4) == 34);
+}
+
+TEST(Extents, Overflow) {
+    // Static extents are fine, but the dynamic extents cause overflow.
+    sanisizer::Extents<std::uint8_t, 5, 5, sanisizer::dynamic_extent>(10);
+    {
+        bool failed = false;
+        try {
+            sanisizer::Extents<std::uint8_t, 5, 5, sanisizer::dynamic_extent>(11);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Static extents after a dynamic extent are still checked.
+    {
+        bool failed = false;
+        try {
+            sanisizer::Extents<std::uint8_t, sanisizer::dynamic_extent, 20>(20);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Dynamic extents themselves are checked.
+    {
+        bool failed = false;
+        try {
+            sanisizer::Extents<std::uint8_t, sanisizer::dynamic_extent>(1000);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
@@ -2,7 +2,11 @@
 
 #include "sanisizer/float.hpp"
 
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 TEST(Float, RequiredBits) {
     EXPECT_EQ(sanisizer::required_bits_for_float(0.), 0);
@@ -104,3 +108,120 @@ TEST(Float, ToFloat) {
     EXPECT_EQ(sanisizer::to_float<double>(sanisizer::Attestation<std::int64_t, 100>((std::int64_t)10)), 10.0);
     EXPECT_EQ(sanisizer::to_float<double>(sanisizer::Attestation<std::int64_t, std::numeric_limits<std::int64_t>::max()>((std::int64_t)10)), 10.0);
 }
+
+TEST(Float, TryFromFloat) {
+    static_assert(noexcept(sanisizer::try_from_float<int>(1.0)));
+
+    EXPECT_EQ(*sanisizer::try_from_float<int>(0.0), 0);
+    EXPECT_EQ(*sanisizer::try_from_float<int>(5.5), 5);
+    EXPECT_EQ(*sanisizer::try_from_float<std::uint8_t>(255.0), 255);
+
+    EXPECT_FALSE(sanisizer::try_from_float<std::uint8_t>(256.0).has_value());
+    EXPECT_FALSE(sanisizer::try_from_float<int>(-1.0).has_value());
+    EXPECT_FALSE(sanisizer::try_from_float<int>(std::numeric_limits<double>::infinity()).has_value());
+    EXPECT_FALSE(sanisizer::try_from_float<int>(std::numeric_limits<double>::quiet_NaN()).has_value());
+}
+
+TEST(Float, TryToFloat) {
+    static_assert(noexcept(sanisizer::try_to_float<double>(1)));
+
+    EXPECT_EQ(*sanisizer::try_to_float<float>(0), 0.0);
+    EXPECT_EQ(*sanisizer::try_to_float<float>(100), 100.0);
+    EXPECT_EQ(*sanisizer::try_to_float<double>(sanisizer::Attestation<std::int64_t, 100>((std::int64_t)10)), 10.0);
+
+    if constexpr(std::numeric_limits<float>::is_iec559) {
+        EXPECT_EQ(*sanisizer::try_to_float<float>(16777216), 16777216.0);
+        EXPECT_FALSE(sanisizer::try_to_float<float>(16777217).has_value());
+        EXPECT_FALSE(sanisizer::try_to_float<double>(9007199254740993).has_value());
+    }
+}
+
+template<typename Integer_, typename Float_>
+void check_from_float_bulk_raw(const std::vector<Float_>& input) {
+    std::vector<Integer_> output(input.size());
+    auto failed = sanisizer::from_float_bulk(input.size(), input.data(), output.data());
+
+    std::size_t expected = input.size();
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        auto ref = sanisizer::try_from_float<Integer_>(input[i]);
+        if (!ref.has_value()) {
+            expected = i;
+            break;
+        }
+        EXPECT_EQ(output[i], *ref);
+    }
+    EXPECT_EQ(failed, expected);
+}
+
+template<typename Integer_, typename Float_>
+void check_from_float_bulk(const std::vector<Float_>& input) {
+    check_from_float_bulk_raw<Integer_>(input);
+
+    // Padding so that the inputs are processed in full blocks.
+    std::vector<Float_> padded(64, 1);
+    padded.insert(padded.end(), input.begin(), input.end());
+    padded.insert(padded.end(), 64, 1);
+    check_from_float_bulk_raw<Integer_>(padded);
+}
+
+TEST(Float, FromFloatBulk) {
+    std::vector<double> input;
+    for (int i = 0; i < 200; ++i) {
+        input.push_back(i * 1.3);
+    }
+    check_from_float_bulk<std::uint8_t>(input);
+    check_from_float_bulk<std::int16_t>(input);
+    check_from_float_bulk<std::uint64_t>(input);
+
+    // Trying invalid values at various positions, including the start and end of each block.
+    std::vector<double> invalid{
+        -1.0,
+        -0.5,
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::quiet_NaN(),
+        100000.0
+    };
+    for (auto val : invalid) {
+        for (std::size_t pos : { 0, 1, 63, 64, 65, 127, 150, 199 }) {
+            auto copy = input;
+            copy[pos] = val;
+            std::vector<std::int16_t> output(copy.size());
+            EXPECT_EQ(sanisizer::from_float_bulk(copy.size(), copy.data(), output.data()), pos);
+            for (std::size_t i = 0; i < pos; ++i) {
+                EXPECT_EQ(output[i], static_cast<std::int16_t>(copy[i]));
+            }
+
+            // Only the first offending index is reported.
+            copy.back() = -1;
+            EXPECT_EQ(sanisizer::from_float_bulk(copy.size(), copy.data(), output.data()), pos);
+        }
+    }
+
+    // Empty inputs are fine.
+    EXPECT_EQ((sanisizer::from_float_bulk<int, double>(0, NULL, NULL)), 0);
+}
+
+TEST(Float, FromFloatBulkLimits) {
+    check_from_float_bulk<std::uint8_t, double>({ -0.0, 255.0, 255.9, 256.0 });
+    check_from_float_bulk<std::uint8_t, double>({ -0.0, 255.0, 255.9, 0.0 });
+    check_from_float_bulk<std::uint8_t, double>({ -std::numeric_limits<double>::quiet_NaN(), 0.0 });
+    check_from_float_bulk<std::uint8_t, double>({ -std::numeric_limits<double>::denorm_min(), 0.0 });
+    check_from_float_bulk<std::uint8_t, double>({ std::numeric_limits<double>::denorm_min(), 0.0 });
+    check_from_float_bulk<std::uint8_t, float>({ -0.0f, 255.9f, -std::numeric_limits<float>::quiet_NaN(), 0.0f });
+    check_from_float_bulk<std::int8_t, double>({ 0.0, 127.0, 127.9, 128.0 });
+    check_from_float_bulk<std::int64_t, double>({ std::nextafter(9223372036854775808.0, 0.0), 9223372036854775808.0 });
+    check_from_float_bulk<std::uint64_t, double>({ std::nextafter(18446744073709551616.0, 0.0), 18446744073709551616.0 });
+
+    {
+        std::vector<double> input{ 0.0, std::nextafter(18446744073709551616.0, 0.0), 18446744073709551616.0 };
+        std::vector<std::uint64_t> output(input.size());
+        EXPECT_EQ(sanisizer::from_float_bulk(input.size(), input.data(), output.data()), 2);
+        EXPECT_EQ(output[1], 18446744073709549568u);
+    }
+
+    // Works with floats.
+    check_from_float_bulk<std::uint8_t, float>({ 1.5f, 255.5f, 256.0f });
+    check_from_float_bulk<std::int32_t, float>({ 2147483520.0f, 2147483648.0f });
+    check_from_float_bulk<std::uint64_t, float>({ 1e19f, 1e20f, std::numeric_limits<float>::infinity() });
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/growth.hpp"
+#include "sanisizer/arena.hpp"
+#include "sanisizer/budget.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+template<typename Type_>
+struct LimitedAllocator : public std::allocator<Type_> {
+    LimitedAllocator() = default;
+    template<typename Other_>
+    LimitedAllocator(const LimitedAllocator<Other_>&) {}
+    template<typename Other_>
+    struct rebind {
+        typedef LimitedAllocator<Other_> other;
+    };
+    std::size_t max_size() const { return 1000; }
+};
+
+TEST(NextCapacity, Basic) {
+    std::vector<int> vec;
+    vec.reserve(10);
+    EXPECT_EQ(vec.capacity(), 10);
+
+    // No growth if the current capacity is sufficient.
+    EXPECT_EQ(sanisizer::next_capacity(vec, 5), 10);
+    EXPECT_EQ(sanisizer::next_capacity(vec, 10), 10);
+
+    // Geometric growth.
+    EXPECT_EQ(sanisizer::next_capacity(vec, 11), 20);
+    EXPECT_EQ(sanisizer::next_capacity(vec, 50), 50);
+
+    sanisizer::GrowthOptions opt;
+    opt.factor_numerator = 3;
+    opt.factor_denominator = 2;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 11, opt), 15);
+
+    // Minimum increment.
+    opt.minimum_increment = 100;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 11, opt), 110);
+
+    // Page rounding, in bytes.
+    sanisizer::GrowthOptions popt;
+    popt.page_size = 4096;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 11, popt), 4096 / sizeof(int));
+    std::vector<int> big;
+    big.reserve(4096);
+    EXPECT_EQ(sanisizer::next_capacity(big, 4097, popt), 8192);
+
+    // Works from an empty container.
+    std::vector<int> empty;
+    EXPECT_EQ(sanisizer::next_capacity(empty, 1), 1);
+    EXPECT_EQ(sanisizer::next_capacity(empty, 1, opt), 100);
+}
+
+TEST(NextCapacity, Limits) {
+    typedef std::vector<int, LimitedAllocator<int> > LimitedVector;
+    LimitedVector vec;
+    vec.reserve(600);
+
+    // Growth is capped at the allocator's limit.
+    EXPECT_EQ(sanisizer::next_capacity(vec, 601), 1000);
+    sanisizer::GrowthOptions popt;
+    popt.page_size = 1 << 20;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 601, popt), 1000);
+
+    bool failed = false;
+    try {
+        sanisizer::next_capacity(vec, 1001);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Large multipliers saturate instead of overflowing.
+    sanisizer::GrowthOptions opt;
+    opt.factor_numerator = std::numeric_limits<std::size_t>::max();
+    EXPECT_EQ(sanisizer::next_capacity(vec, 601, opt), 1000);
+    opt.factor_numerator = 2;
+    opt.minimum_increment = std::numeric_limits<std::size_t>::max();
+    EXPECT_EQ(sanisizer::next_capacity(vec, 601, opt), 1000);
+}
+
+TEST(NextCapacity, MaximumBytes) {
+    std::vector<int> vec;
+    vec.reserve(100);
+
+    sanisizer::GrowthOptions opt;
+    opt.maximum_bytes = 150 * sizeof(int);
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101, opt), 150);
+    EXPECT_EQ(sanisizer::next_capacity(vec, 120, opt), 150);
+
+    // Never less than the required size.
+    EXPECT_EQ(sanisizer::next_capacity(vec, 180, opt), 180);
+
+    // Applied after page rounding.
+    opt.page_size = 4096;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101, opt), 150);
+}
+
+TEST(NextCapacity, BudgetAllocator) {
+    sanisizer::MemoryBudget budget(1000);
+    std::vector<int, sanisizer::BudgetAllocator<int> > vec{ sanisizer::BudgetAllocator<int>(budget) };
+    vec.reserve(100);
+    EXPECT_EQ(budget.available(), 600);
+
+    // max_size() does not reflect the remaining budget...
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101), 200);
+    bool failed = false;
+    try {
+        sanisizer::reserve_for_append(vec, 101);
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(vec.capacity(), 100);
+
+    // ... so it needs to be supplied explicitly.
+    sanisizer::GrowthOptions opt;
+    opt.maximum_bytes = budget.available();
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101, opt), 150);
+    sanisizer::reserve_for_append(vec, 101, opt);
+    EXPECT_EQ(vec.capacity(), 150);
+    EXPECT_EQ(budget.used(), 600);
+}
+
+TEST(NextCapacity, ArenaAllocator) {
+    sanisizer::Arena arena(1000);
+    std::vector<int, sanisizer::ArenaAllocator<int> > vec{ sanisizer::ArenaAllocator<int>(arena) };
+    vec.reserve(100);
+
+    // Capped by the arena's capacity.
+    sanisizer::GrowthOptions big;
+    big.factor_numerator = 10;
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101, big), 250);
+
+    // Capped by the remaining space.
+    sanisizer::GrowthOptions opt;
+    opt.maximum_bytes = arena.available();
+    EXPECT_EQ(sanisizer::next_capacity(vec, 101, opt), 150);
+    sanisizer::reserve_for_append(vec, 101, opt);
+    EXPECT_EQ(vec.capacity(), 150);
+    EXPECT_EQ(arena.used(), 1000);
+
+    bool failed = false;
+    try {
+        sanisizer::reserve_for_append(vec, 151);
+    } catch (std::bad_alloc& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+TEST(ReserveForAppend, Basic) {
+    std::vector<int> vec(10);
+    vec.shrink_to_fit();
+    sanisizer::reserve_for_append(vec, 0);
+    EXPECT_EQ(vec.capacity(), 10);
+
+    sanisizer::reserve_for_append(vec, 1);
+    EXPECT_EQ(vec.capacity(), 20);
+    sanisizer::reserve_for_append(vec, 10);
+    EXPECT_EQ(vec.capacity(), 20);
+    sanisizer::reserve_for_append(vec, sanisizer::Attestation<int, 100>(11));
+    EXPECT_EQ(vec.capacity(), 40);
+
+    bool failed = false;
+    try {
+        sanisizer::reserve_for_append(vec, std::numeric_limits<std::size_t>::max());
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    failed = false;
+    try {
+        sanisizer::reserve_for_append(vec, std::numeric_limits<std::size_t>::max() / 2);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/odometer.hpp"
+#include "sanisizer/nd_offset.hpp"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+TEST(Odometer, Full) {
+    sanisizer::Odometer<int, 3> odo(std::array<int, 3>{ 2, 3, 4 });
+    EXPECT_EQ(odo.size(), 24);
+
+    int expected = 0;
+    for (int k = 0; k < 4; ++k) {
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 2; ++i) {
+                EXPECT_TRUE(odo.valid());
+                EXPECT_EQ(odo.offset(), expected);
+                std::array<int, 3> pos{ i, j, k };
+                EXPECT_EQ(odo.position(), pos);
+                odo.next();
+                ++expected;
+            }
+        }
+    }
+    EXPECT_FALSE(odo.valid());
+
+    // Same results from a Shape.
+    sanisizer::Shape<int, 3> shape(2, 3, 4);
+    sanisizer::Odometer<int, 3> sodo(shape);
+    EXPECT_EQ(sodo.size(), 24);
+    expected = 0;
+    for (; sodo.valid(); sodo.next()) {
+        EXPECT_EQ(sodo.offset(), expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, 24);
+
+    // Copies are independent.
+    sanisizer::Odometer<int, 3> original(shape);
+    auto copy = original;
+    copy.next();
+    EXPECT_EQ(copy.offset(), 1);
+    EXPECT_EQ(original.offset(), 0);
+}
+
+TEST(Odometer, Region) {
+    std::vector<int> extents{ 5, 6, 7 };
+    std::vector<int> start{ 1, 2, 3 };
+    std::vector<int> count{ 3, 2, 4 };
+
+    std::vector<std::size_t> expected;
+    for (int k = 0; k < count[2]; ++k) {
+        for (int j = 0; j < count[1]; ++j) {
+            for (int i = 0; i < count[0]; ++i) {
+                expected.push_back(sanisizer::nd_offset<std::size_t>(start[0] + i, extents[0], start[1] + j, extents[1], start[2] + k));
+            }
+        }
+    }
+
+    // Runtime rank.
+    {
+        sanisizer::Odometer<std::size_t> odo(extents, start, count);
+        EXPECT_EQ(odo.size(), 24u);
+        std::vector<std::size_t> observed;
+        for (; odo.valid(); odo.next()) {
+            observed.push_back(odo.offset());
+        }
+        EXPECT_EQ(observed, expected);
+    }
+
+    // Compile-time rank.
+    {
+        sanisizer::Shape<std::size_t, 3> shape(5, 6, 7);
+        sanisizer::Odometer<std::size_t, 3> odo(shape, start, count);
+        std::vector<std::size_t> observed;
+        for (; odo.valid(); odo.next()) {
+            observed.push_back(odo.offset());
+        }
+        EXPECT_EQ(observed, expected);
+    }
+
+    // Visiting.
+    {
+        sanisizer::Odometer<std::size_t> odo(extents, start, count);
+        std::vector<std::size_t> observed;
+        odo.visit([&](std::size_t o) -> void { observed.push_back(o); });
+        EXPECT_EQ(observed, expected);
+        EXPECT_FALSE(odo.valid());
+    }
+
+    // Visiting after partial iteration.
+    {
+        sanisizer::Odometer<std::size_t, 3> odo(extents, start, count);
+        std::vector<std::size_t> observed;
+        for (int i = 0; i < 5; ++i) {
+            observed.push_back(odo.offset());
+            odo.next();
+        }
+        odo.visit([&](std::size_t o) -> void { observed.push_back(o); });
+        EXPECT_EQ(observed, expected);
+    }
+}
+
+TEST(Odometer, Empty) {
+    sanisizer::Odometer<int> odo(std::vector<int>{ 5, 0, 7 });
+    EXPECT_EQ(odo.size(), 0);
+    EXPECT_FALSE(odo.valid());
+    bool visited = false;
+    odo.visit([&](int) -> void { visited = true; });
+    EXPECT_FALSE(visited);
+
+    // Empty region at the very end of the array.
+    sanisizer::Odometer<std::uint8_t> eodo(std::vector<int>{ 15, 15 }, std::vector<int>{ 15, 15 }, std::vector<int>{ 0, 0 });
+    EXPECT_FALSE(eodo.valid());
+
+    // Zero dimensions.
+    sanisizer::Odometer<int> zodo(std::vector<int>{});
+    EXPECT_EQ(zodo.size(), 1);
+    EXPECT_TRUE(zodo.valid());
+    EXPECT_EQ(zodo.offset(), 0);
+    zodo.next();
+    EXPECT_FALSE(zodo.valid());
+
+    sanisizer::Odometer<int> zvodo(std::vector<int>{});
+    int visits = 0;
+    zvodo.visit([&](int o) -> void {
+        EXPECT_EQ(o, 0);
+        ++visits;
+    });
+    EXPECT_EQ(visits, 1);
+}
+
+TEST(Odometer, Limits) {
+    // Iterating to the very last element does not overflow.
+    sanisizer::Odometer<std::uint8_t> odo(std::vector<int>{ 15, 17 });
+    EXPECT_EQ(odo.size(), 255);
+    int counter = 0;
+    odo.visit([&](std::uint8_t o) -> void {
+        EXPECT_EQ(o, counter);
+        ++counter;
+    });
+    EXPECT_EQ(counter, 255);
+
+    sanisizer::Odometer<std::uint8_t> codo(std::vector<int>{ 15, 17 }, std::vector<int>{ 14, 16 }, std::vector<int>{ 1, 1 });
+    EXPECT_EQ(codo.offset(), 254);
+    codo.next();
+    EXPECT_FALSE(codo.valid());
+}
+
+TEST(Odometer, Errors) {
+    auto expect_error = [](auto fun) -> void {
+        bool failed = false;
+        try {
+            fun();
+        } catch (std::exception& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    };
+
+    expect_error([]() -> void { sanisizer::Odometer<std::uint8_t>(std::vector<int>{ 16, 16 }); });
+    expect_error([]() -> void { sanisizer::Odometer<int, 2>(std::vector<int>{ 16, 16, 16 }); });
+    expect_error([]() -> void { sanisizer::Odometer<int>(std::vector<int>{ 16, 16 }, std::vector<int>{ 10, 10 }, std::vector<int>{ 5, 7 }); });
+    expect_error([]() -> void { sanisizer::Odometer<int>(std::vector<int>{ 16, 16 }, std::vector<int>{ 17, 0 }, std::vector<int>{ 0, 0 }); });
+    expect_error([]() -> void { sanisizer::Odometer<int>(std::vector<int>{ 16, 16 }, std::vector<int>{ 0 }, std::vector<int>{ 1, 1 }); });
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/overwrite.hpp"
+#include "sanisizer/create.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(DefaultInitAllocator, Basic) {
+    sanisizer::DefaultInitVector<double> x(10);
+    EXPECT_EQ(x.size(), 10);
+
+    // Values are still used if supplied.
+    sanisizer::DefaultInitVector<int> y(10, 5);
+    EXPECT_EQ(y, sanisizer::DefaultInitVector<int>({ 5, 5, 5, 5, 5, 5, 5, 5, 5, 5 }));
+    y.resize(20, 2);
+    EXPECT_EQ(y.back(), 2);
+    y.push_back(3);
+    EXPECT_EQ(y.back(), 3);
+
+    // Non-trivial types are still default-constructed.
+    sanisizer::DefaultInitVector<std::string> z(5);
+    EXPECT_EQ(z.front(), "");
+    z.emplace_back("foo");
+    EXPECT_EQ(z.back(), "foo");
+
+    // Works with the other creation functions.
+    auto created = sanisizer::create<sanisizer::DefaultInitVector<std::uint8_t> >(100);
+    EXPECT_EQ(created.size(), 100);
+    sanisizer::resize(created, 200);
+    EXPECT_EQ(created.size(), 200);
+
+    // Rebinding and comparisons work as expected.
+    sanisizer::DefaultInitAllocator<int> alloc;
+    sanisizer::DefaultInitAllocator<double> alloc2(alloc);
+    EXPECT_TRUE(alloc == alloc2);
+
+    // Treated as a standard allocator for the purposes of checking the allocation size.
+    static_assert(!sanisizer::needs_allocation_check<sanisizer::DefaultInitVector<int>, std::uint8_t>());
+}
+
+TEST(CreateUniqueForOverwrite, Basic) {
+    auto ptr = sanisizer::create_unique_for_overwrite<double>(10);
+    for (int i = 0; i < 10; ++i) {
+        ptr[i] = i;
+    }
+    EXPECT_EQ(ptr[9], 9);
+
+    auto attested = sanisizer::create_unique_for_overwrite<int>(sanisizer::Attestation<int, 100>(50));
+    attested[49] = 1;
+    EXPECT_EQ(attested[49], 1);
+
+    bool failed = false;
+    try {
+        sanisizer::create_unique_for_overwrite<std::uint32_t>(std::numeric_limits<std::size_t>::max() / 2);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // Fails before reaching new[], even if the number of bytes fits in a size_t.
+    std::string msg;
+    try {
+        sanisizer::create_unique_for_overwrite<double>(std::numeric_limits<std::size_t>::max() / 8 - 1);
+    } catch (std::overflow_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("maximum allocation size") != std::string::npos);
+}
+
+TEST(CreateVectorForOverwrite, Basic) {
+    auto vec = sanisizer::create_vector_for_overwrite<double>(10);
+    EXPECT_EQ(vec.size(), 10);
+
+    bool failed = false;
+    try {
+        sanisizer::create_vector_for_overwrite<std::uint64_t>(std::numeric_limits<std::size_t>::max() / 4);
+    } catch (std::overflow_error& e) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/partition.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+TEST(ContiguousPartition, Basic) {
+    sanisizer::ContiguousPartition<int> part(10, 3);
+    EXPECT_EQ(part.num_tasks(), 10);
+    EXPECT_EQ(part.num_workers(), 3);
+
+    auto r0 = part.range(0);
+    EXPECT_EQ(r0.start, 0);
+    EXPECT_EQ(r0.length, 4);
+    auto r1 = part.range(1);
+    EXPECT_EQ(r1.start, 4);
+    EXPECT_EQ(r1.length, 3);
+    auto r2 = part.range(2);
+    EXPECT_EQ(r2.start, 7);
+    EXPECT_EQ(r2.length, 3);
+
+    for (int t = 0; t < 10; ++t) {
+        auto w = part.owner(t);
+        auto r = part.range(w);
+        EXPECT_GE(t, r.start);
+        EXPECT_LT(t, r.start + r.length);
+    }
+}
+
+TEST(ContiguousPartition, Exhaustive) {
+    for (int n = 0; n < 50; ++n) {
+        for (int k = 1; k < 12; ++k) {
+            sanisizer::ContiguousPartition<unsigned char> part(n, k);
+            std::vector<int> owners(n, -1);
+            int expected_start = 0;
+            for (int w = 0; w < k; ++w) {
+                auto r = part.range(w);
+                EXPECT_EQ(r.start, expected_start);
+                EXPECT_LE(r.length, n / k + 1);
+                EXPECT_GE(r.length, n / k);
+                for (int t = r.start; t < r.start + r.length; ++t) {
+                    owners[t] = w;
+                }
+                expected_start += r.length;
+            }
+            EXPECT_EQ(expected_start, n);
+            for (int t = 0; t < n; ++t) {
+                EXPECT_EQ(part.owner(t), owners[t]);
+            }
+        }
+    }
+}
+
+TEST(ContiguousPartition, Extremes) {
+    constexpr auto limit = std::numeric_limits<std::uint64_t>::max();
+    {
+        sanisizer::ContiguousPartition<std::uint64_t> part(limit, 7);
+        auto last = part.range(6);
+        EXPECT_EQ(last.start + last.length, limit);
+        EXPECT_EQ(part.owner(limit - 1), 6);
+        EXPECT_EQ(part.owner(0), 0);
+    }
+    {
+        sanisizer::ContiguousPartition<std::uint64_t> part(limit, 1);
+        auto only = part.range(0);
+        EXPECT_EQ(only.start, 0);
+        EXPECT_EQ(only.length, limit);
+        EXPECT_EQ(part.owner(limit - 1), 0);
+    }
+    {
+        sanisizer::ContiguousPartition<std::uint8_t> part(255, 255);
+        auto last = part.range(254);
+        EXPECT_EQ(last.start, 254);
+        EXPECT_EQ(last.length, 1);
+        EXPECT_EQ(part.owner(254), 254);
+    }
+}
+
+TEST(ContiguousPartition, Empty) {
+    sanisizer::ContiguousPartition<int> part(0, 4);
+    EXPECT_EQ(part.num_tasks(), 0);
+    EXPECT_EQ(part.num_workers(), 4);
+    for (int w = 0; w < 4; ++w) {
+        auto r = part.range(w);
+        EXPECT_EQ(r.start, 0);
+        EXPECT_EQ(r.length, 0);
+    }
+
+    sanisizer::ContiguousPartition<std::uint8_t> upart(0, 255);
+    auto last = upart.range(254);
+    EXPECT_EQ(last.start, 0);
+    EXPECT_EQ(last.length, 0);
+}
+
+TEST(ContiguousPartition, Errors) {
+    std::string msg;
+    try {
+        sanisizer::ContiguousPartition<int> part(10, 0);
+    } catch (std::domain_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("positive") != std::string::npos);
+
+    msg.clear();
+    try {
+        sanisizer::ContiguousPartition<std::uint8_t> part(10, 1000);
+    } catch (std::overflow_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("overflow") != std::string::npos);
+
+    msg.clear();
+    try {
+        sanisizer::ContiguousPartition<std::uint64_t, std::int8_t> part(10, 1000);
+    } catch (std::overflow_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("overflow") != std::string::npos);
+
+    msg.clear();
+    try {
+        sanisizer::ContiguousPartition<std::uint8_t> part(1000, 10);
+    } catch (std::overflow_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("overflow") != std::string::npos);
+}
+
+TEST(BlockPartition, Basic) {
+    sanisizer::BlockPartition<int> part(10, 4);
+    EXPECT_EQ(part.num_tasks(), 10);
+    EXPECT_EQ(part.block_size(), 4);
+    EXPECT_EQ(part.num_blocks(), 3);
+
+    auto r0 = part.range(0);
+    EXPECT_EQ(r0.start, 0);
+    EXPECT_EQ(r0.length, 4);
+    auto r2 = part.range(2);
+    EXPECT_EQ(r2.start, 8);
+    EXPECT_EQ(r2.length, 2);
+
+    EXPECT_EQ(part.owner(3), 0);
+    EXPECT_EQ(part.owner(4), 1);
+    EXPECT_EQ(part.owner(9), 2);
+
+}
+
+TEST(BlockPartition, Empty) {
+    sanisizer::BlockPartition<int> empty(0, 4);
+    EXPECT_EQ(empty.num_tasks(), 0);
+    EXPECT_EQ(empty.block_size(), 4);
+    EXPECT_EQ(empty.num_blocks(), 0);
+
+    sanisizer::BlockPartition<std::uint8_t> uempty(0, 255);
+    EXPECT_EQ(uempty.num_blocks(), 0);
+
+    sanisizer::BlockCyclicPartition<int> cyclic(0, 4, 3);
+    EXPECT_EQ(cyclic.blocks().num_blocks(), 0);
+    for (int w = 0; w < 3; ++w) {
+        EXPECT_EQ(cyclic.num_blocks(w), 0);
+    }
+}
+
+TEST(BlockPartition, Extremes) {
+    sanisizer::BlockPartition<std::uint8_t> part(255, 100);
+    EXPECT_EQ(part.num_blocks(), 3);
+    auto last = part.range(2);
+    EXPECT_EQ(last.start, 200);
+    EXPECT_EQ(last.length, 55);
+    EXPECT_EQ(part.owner(254), 2);
+
+    sanisizer::BlockPartition<std::uint8_t> whole(255, 255);
+    EXPECT_EQ(whole.num_blocks(), 1);
+    EXPECT_EQ(whole.range(0).length, 255);
+
+    bool failed = false;
+    try {
+        sanisizer::BlockPartition<int> bad(10, 0);
+    } catch (std::domain_error&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+TEST(BlockCyclicPartition, Exhaustive) {
+    for (int n = 0; n < 40; ++n) {
+        for (int b = 1; b < 6; ++b) {
+            for (int k = 1; k < 5; ++k) {
+                sanisizer::BlockCyclicPartition<std::uint8_t> part(n, b, k);
+                EXPECT_EQ(part.num_workers(), k);
+                EXPECT_EQ(part.blocks().num_blocks(), (n + b - 1) / b);
+
+                std::vector<int> owners(n, -1);
+                int total = 0;
+                for (int w = 0; w < k; ++w) {
+                    auto nb = part.num_blocks(w);
+                    for (int i = 0; i < nb; ++i) {
+                        auto r = part.range(w, i);
+                        EXPECT_EQ(r.start, (w + i * k) * b);
+                        for (int t = r.start; t < r.start + r.length; ++t) {
+                            EXPECT_EQ(owners[t], -1);
+                            owners[t] = w;
+                        }
+                        total += r.length;
+                    }
+                }
+                EXPECT_EQ(total, n);
+                for (int t = 0; t < n; ++t) {
+                    EXPECT_EQ(part.owner(t), owners[t]);
+                }
+            }
+        }
+    }
+}
+
+TEST(BlockCyclicPartition, Extremes) {
+    constexpr auto limit = std::numeric_limits<std::uint64_t>::max();
+    sanisizer::BlockCyclicPartition<std::uint64_t> part(limit, limit / 2, 2);
+    EXPECT_EQ(part.blocks().num_blocks(), 3);
+    EXPECT_EQ(part.num_blocks(0), 2);
+    EXPECT_EQ(part.num_blocks(1), 1);
+    auto last = part.range(0, 1);
+    EXPECT_EQ(last.start + last.length, limit);
+    EXPECT_EQ(last.length, 1);
+    EXPECT_EQ(part.owner(limit - 1), 0);
+
+    bool failed = false;
+    try {
+        sanisizer::BlockCyclicPartition<int> bad(10, 2, 0);
+    } catch (std::domain_error&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
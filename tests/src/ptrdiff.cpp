@@ -2,6 +2,10 @@
 #include <cstddef>
 #include <string>
 #include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "sanisizer/ptrdiff.hpp"
 
@@ -50,3 +54,72 @@ TEST(CanPtrdiff, Basic) {
     // Works at compile time.
     static_assert(sanisizer::can_ptrdiff<double*>(10));
 }
+
+struct MockRandomIterator {
+    MockRandomIterator(std::size_t pos) : pos(pos) {}
+    std::size_t pos;
+};
+
+static std::int8_t operator-(const MockRandomIterator& left, const MockRandomIterator& right) {
+    return left.pos - right.pos;
+}
+
+static MockRandomIterator operator+(const MockRandomIterator& left, std::int8_t right) {
+    return MockRandomIterator(left.pos + right);
+}
+
+TEST(PtrdiffRange, Pointers) {
+    std::vector<double> x(20);
+    std::iota(x.begin(), x.end(), 0);
+
+    sanisizer::PtrdiffRange<double*> range(x.data(), x.size());
+    static_assert(std::is_same<decltype(range)::Difference, std::ptrdiff_t>::value);
+    EXPECT_EQ(range.begin(), x.data());
+    EXPECT_EQ(range.end(), x.data() + 20);
+    EXPECT_EQ(range.size(), 20);
+    EXPECT_FALSE(range.empty());
+    EXPECT_EQ(*range.at(5), 5);
+    EXPECT_EQ(range.offset(x.data() + 7), 7);
+
+    auto sub = range.subrange(5, 10);
+    EXPECT_EQ(sub.size(), 10);
+    EXPECT_EQ(*sub.begin(), 5);
+    EXPECT_EQ(*(sub.end() - 1), 14);
+    EXPECT_EQ(sub.offset(x.data() + 12), 7);
+
+    auto rest = range.subrange(15);
+    EXPECT_EQ(rest.size(), 5);
+    EXPECT_EQ(*rest.begin(), 15);
+    EXPECT_EQ(rest.end(), range.end());
+
+    auto empty = range.subrange(20);
+    EXPECT_TRUE(empty.empty());
+
+    // Works with Attestations.
+    sanisizer::PtrdiffRange<const double*> attested(x.data(), sanisizer::Attestation<int, 20>(10));
+    EXPECT_EQ(attested.size(), 10);
+}
+
+TEST(PtrdiffRange, Custom) {
+    sanisizer::PtrdiffRange<MockRandomIterator> range(MockRandomIterator(100), 127);
+    static_assert(std::is_same<decltype(range)::Difference, std::int8_t>::value);
+    EXPECT_EQ(range.size(), 127);
+    EXPECT_EQ(range.end().pos, 227);
+    EXPECT_EQ(range.at(20).pos, 120);
+    EXPECT_EQ(range.offset(MockRandomIterator(200)), 100);
+
+    auto sub = range.subrange(27, 50);
+    EXPECT_EQ(sub.begin().pos, 127);
+    EXPECT_EQ(sub.end().pos, 177);
+    auto subsub = sub.subrange(10);
+    EXPECT_EQ(subsub.size(), 40);
+    EXPECT_EQ(subsub.begin().pos, 137);
+
+    std::string msg;
+    try {
+        sanisizer::PtrdiffRange<MockRandomIterator> bad(MockRandomIterator(0), 128);
+    } catch (std::overflow_error& e) {
+        msg = e.what();
+    }
+    EXPECT_TRUE(msg.find("overflow") != std::string::npos);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "sanisizer/shape.hpp"
+#include "sanisizer/nd_offset.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+TEST(Shape, Basic) {
+    sanisizer::Shape<int, 3> shape(2, 3, 4);
+    EXPECT_EQ(shape.ndim(), 3);
+    EXPECT_EQ(shape.size(), 24);
+    EXPECT_EQ(shape.extent(0), 2);
+    EXPECT_EQ(shape.extent(1), 3);
+    EXPECT_EQ(shape.extent(2), 4);
+    EXPECT_EQ(shape.stride(0), 1);
+    EXPECT_EQ(shape.stride(1), 2);
+    EXPECT_EQ(shape.stride(2), 6);
+
+    // Consistent with nd_offset().
+    int expected = 0;
+    for (int k = 0; k < 4; ++k) {
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 2; ++i) {
+                EXPECT_EQ(shape.offset(i, j, k), sanisizer::nd_offset<int>(i, 2, j, 3, k));
+                EXPECT_EQ(shape.offset(i, j, k), expected);
+                ++expected;
+            }
+        }
+    }
+
+    // Works with a single dimension.
+    sanisizer::Shape<std::size_t, 1> vec(10u);
+    EXPECT_EQ(vec.size(), 10u);
+    EXPECT_EQ(vec.offset(5), 5u);
+
+    // Works with mixed types.
+    sanisizer::Shape<std::uint32_t, 2> mixed(std::uint8_t(10), sanisizer::Attestation<std::uint64_t, 100>(20));
+    EXPECT_EQ(mixed.size(), 200u);
+    EXPECT_EQ(mixed.offset(std::uint8_t(9), 19), 199u);
+
+    // Works at compile time.
+    constexpr sanisizer::Shape<int, 3> cshape(5, 6, 7);
+    static_assert(cshape.size() == 210);
+    static_assert(cshape.offset(4, 5, 6) == 209);
+}
+
+TEST(Shape, Empty) {
+    sanisizer::Shape<std::uint8_t, 3> shape(10, 0, 20);
+    EXPECT_EQ(shape.size(), 0);
+    EXPECT_EQ(shape.stride(2), 0);
+}
+
+TEST(Shape, Overflow) {
+    {
+        bool failed = false;
+        try {
+            sanisizer::Shape<std::uint8_t, 2>(20, 20);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Strides are also checked, even if the total size is zero.
+    {
+        bool failed = false;
+        try {
+            sanisizer::Shape<std::uint8_t, 3>(20, 20, 0);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+
+    // Extents themselves are checked.
+    {
+        bool failed = false;
+        try {
+            sanisizer::Shape<std::uint8_t, 2>(1000, 0);
+        } catch (std::overflow_error& e) {
+            failed = true;
+        }
+        EXPECT_TRUE(failed);
+    }
+}
+
+TEST(Shape, Offsets) {
+    sanisizer::Shape<int, 3> shape(5, 6, 7);
+    std::vector<int> x{ 0, 4, 2, 3, 1 };
+    std::vector<int> y{ 0, 5, 1, 0, 2 };
+    std::vector<int> z{ 0, 6, 3, 2, 4 };
+    const std::array<const int*, 3> coordinates{ x.data(), y.data(), z.data() };
+
+    std::vector<int> expected;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        expected.push_back(shape.offset(x[i], y[i], z[i]));
+    }
+
+    std::vector<int> output(x.size());
+    shape.offsets(x.size(), coordinates, output.data());
+    EXPECT_EQ(output, expected);
+
+    std::vector<std::size_t> validated(x.size());
+    EXPECT_EQ(shape.offsets_validated(x.size(), coordinates, validated.begin()), 0u);
+    EXPECT_EQ(validated, std::vector<std::size_t>(expected.begin(), expected.end()));
+
+    // Works with iterators to Attestations.
+    typedef sanisizer::Attestation<std::uint64_t, 100> Attested100;
+    std::vector<Attested100> ax, ay, az;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ax.emplace_back(x[i]);
+        ay.emplace_back(y[i]);
+        az.emplace_back(z[i]);
+    }
+    std::fill(output.begin(), output.end(), -1);
+    shape.offsets(x.size(), std::array<std::vector<Attested100>::const_iterator, 3>{ ax.cbegin(), ay.cbegin(), az.cbegin() }, output.begin());
+    EXPECT_EQ(output, expected);
+}
+
+TEST(Shape, OffsetsValidated) {
+    sanisizer::Shape<std::int8_t, 2> shape(10, 12);
+    std::vector<int> x{ 0, 10, 5, -1, 9, 1000 };
+    std::vector<int> y{ 0, 0, 12, 3, 11, -1000 };
+    std::vector<std::int8_t> output(x.size());
+
+    EXPECT_EQ(shape.offsets_validated(x.size(), std::array<const int*, 2>{ x.data(), y.data() }, output.data()), 4);
+    std::vector<std::int8_t> expected{ 0, 120, 120, 120, 119, 120 };
+    EXPECT_EQ(output, expected);
+
+    // Sentinel can be used to find the first invalid element.
+    EXPECT_EQ(std::find(output.begin(), output.end(), shape.size()) - output.begin(), 1);
+
+    // Unsigned coordinates are only checked against the upper bound.
+    std::vector<std::uint64_t> ux{ 9, 10 };
+    std::vector<std::uint64_t> uy{ 11, 0xFFFFFFFFFFFFFFFF };
+    EXPECT_EQ(shape.offsets_validated(ux.size(), std::array<const std::uint64_t*, 2>{ ux.data(), uy.data() }, output.data()), 1);
+    EXPECT_EQ(output[0], 119);
+    EXPECT_EQ(output[1], 120);
+}